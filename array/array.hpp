@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+namespace Handmade {
+    template<typename T, std::size_t N>
+    class Array final {
+        using value_type = T;
+
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        using size_type = std::size_t;
+
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+
+        size_type m_size = 0;
+        size_type m_size_max = N;
+
+        T m_arr[N];
+    public:
+        Array() = default;
+
+        constexpr explicit Array(const std::initializer_list<value_type> &list) : m_size(list.size()) {
+            if(m_size > m_size_max) { 
+                throw std::length_error("data sheet size is larger than acceptable range");
+            }
+
+            for(size_type i{}; i < m_size; ++i){ 
+                m_arr[i] = *(list.begin() + i); 
+            }
+        }
+
+        // Копия диапазона, например таблицы из np::vector, построенной в consteval-функции:
+        //     constexpr auto table = [] { np::vector<int> v; ...; return Array<int, 256>(v.begin(), v.end()); }();
+        // Элементы за концом диапазона инициализируются значением, чтобы массив годился для constexpr.
+        template<std::input_iterator InputIt>
+        constexpr Array(InputIt first, InputIt last) : m_arr{} {
+            for(; first != last; ++first, ++m_size) {
+                if(m_size == m_size_max) {
+                    throw std::length_error("data sheet size is larger than acceptable range");
+                }
+
+                m_arr[m_size] = *first;
+            }
+        }
+
+        // Прежние копирующие конструктор и присваивание копировали только m_size элементов
+        // приёмника (в конструкторе - ни одного), а operator= ничего не возвращал
+        constexpr Array(const Array<value_type, N>& other) = default;
+        constexpr Array<value_type, N>& operator=(const Array<value_type, N>& other) = default;
+
+        //operators
+
+        constexpr reference operator[](const size_type pos) {
+            return m_arr[pos];
+        }
+
+        constexpr const_reference operator[](const size_type pos)const {
+            return m_arr[pos];
+        }
+
+        
+        /////////////new////////////////////////////////////        
+        constexpr bool operator<(const Array<value_type, N>& other) const {
+            for(size_type i{}; i < m_size; ++i){
+                if(m_arr[i] >= other.m_arr[i]){
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // > и == раньше выражались друг через друга через <= и уходили в бесконечную рекурсию.
+        // Сравниваются только занятые m_size элементов: остальные не инициализированы.
+        constexpr bool operator>(const Array<value_type, N>& other) const {
+    		return other < *this;
+	}
+
+	constexpr bool operator==(const Array<value_type, N>& other) const {
+    		if(m_size != other.m_size){
+    		    return false;
+    		}
+    		for(size_type i{}; i < m_size; ++i){
+    		    if(!(m_arr[i] == other.m_arr[i])){
+    		        return false;
+    		    }
+    		}
+    		return true;
+	}
+
+	constexpr bool operator!=(const Array<value_type, N>& other) const {
+    		return !(*this == other);
+	}
+
+	constexpr bool operator<=(const Array<value_type, N>& other) const {
+    		return (*this < other) || (*this == other);
+	}
+
+	constexpr bool operator>=(const Array<value_type, N>& other) const {
+    		return (*this > other) || (*this == other);
+	}
+        ////////////////////////////////////////////////////
+
+        // no-const function
+
+        constexpr reference front() {
+            return m_arr[0];
+        }
+
+        constexpr reference back() {
+            return m_arr[m_size_max - 1];
+        }
+
+        constexpr reference at(const size_type pos) {
+            if(pos >= m_size_max){
+                throw std::out_of_range("incorrect index for obtaining a resource");
+            } 
+
+            return m_arr[pos];
+        }
+
+        constexpr void fill(const value_type& value) {
+            for(auto& item : m_arr) {
+                item = value;
+            }
+        }
+
+        constexpr pointer data() noexcept {
+            return m_arr;
+        }
+
+        // Меняет число занятых элементов, не трогая их значения (например, после чтения в data())
+        constexpr void resize(const size_type count) {
+            if(count > m_size_max) {
+                throw std::length_error("data sheet size is larger than acceptable range");
+            }
+
+            m_size = count;
+        }
+
+        constexpr void swap(Array<value_type, N>& other) noexcept {
+            Array<value_type, N> temporary_array = *this;
+            *this = other;
+            other = temporary_array;
+        }
+
+        //const function
+
+        constexpr const_reference front()const {
+            return m_arr[0];
+        }
+
+        constexpr const_reference back()const {
+            return m_arr[m_size_max - 1];
+        }
+
+        constexpr const_reference at(const size_type pos)const {
+            if(pos >= m_size_max){
+                throw std::out_of_range("incorrect index for obtaining a resource");
+            } 
+
+            return m_arr[pos];
+        }
+
+        constexpr size_type size()const {
+            return m_size;
+        }
+
+        constexpr bool empty()const {
+            return m_size == 0;
+        }
+
+        constexpr const_pointer data() const {
+            return m_arr;
+        }
+
+        constexpr ~Array() = default;
+    };
+
+  template<std::size_t I, typename T, std::size_t N>
+  constexpr T& get(Array<T,N>& a) noexcept {
+    return a[I];
+  }
+
+  template<std::size_t I, typename T, std::size_t N>
+  constexpr const T& get(const Array<T,N>& a) noexcept {
+    return a[I];
+  }
+}
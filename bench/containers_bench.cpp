@@ -0,0 +1,462 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../array/array.hpp"
+#include "../list/list.hpp"
+#include "../map_/map.hpp"
+#include "../vector/vector.hpp"
+
+// Сравнение контейнеров np (np::vector, List, Map, Handmade::Array) со стандартными аналогами:
+// push_back, insert, erase, проход, поиск и сортировка на размерах от 16 до 100M и нескольких
+// типах элементов. Каждая строка - лучшее время из нескольких повторов в нс на операцию.
+//
+//   containers_bench [--min-size N] [--max-size N] [--filter STR] [--json FILE] [--smoke]
+//
+// --json пишет все результаты массивом объектов {container, type, op, size, ops, ns_per_op}.
+// Узловые контейнеры и строки ограничены 16M элементов, List::sort (пузырёк) - 4096,
+// Map заполняется случайными ключами: дерево не балансируется.
+
+namespace {
+    struct options {
+        std::size_t min_size = 16;
+        std::size_t max_size = 100'000'000;
+        std::string filter;
+        std::string json_path;
+        int max_repeats = 20;
+    };
+
+    struct record {
+        std::string container;
+        std::string type;
+        std::string op;
+        std::size_t size;
+        std::size_t ops;
+        double ns_per_op;
+    };
+
+    options config;
+    np::vector<record> results;
+
+    volatile std::uint64_t sink = 0;
+
+    constexpr std::size_t node_size_limit = std::size_t(1) << 24;
+    constexpr std::size_t bubble_sort_limit = 4096;
+
+    constexpr std::size_t sizes[] = {16, 256, 4096, 65536, std::size_t(1) << 20, std::size_t(1) << 24, 100'000'000};
+
+    /***************************/
+    // Значения элементов по номеру: одинаковые для np и std
+    template <typename T>
+    T make_value(const std::uint64_t seed) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return "key-" + std::to_string(seed * 2654435761u);
+        }
+        else {
+            return static_cast<T>(seed * 2654435761u % 1'000'000'007u);
+        }
+    }
+
+    template <typename T> constexpr const char* type_name = "";
+    template <> constexpr const char* type_name<std::int32_t> = "int32";
+    template <> constexpr const char* type_name<std::uint64_t> = "uint64";
+    template <> constexpr const char* type_name<double> = "double";
+    template <> constexpr const char* type_name<std::string> = "string";
+
+    template <typename T>
+    std::uint64_t digest(const T& value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return value.size();
+        }
+        else {
+            return static_cast<std::uint64_t>(value);
+        }
+    }
+
+    // Сколько раз повторить замер: мелкие размеры - чаще, чтобы уйти от шума таймера. Каждый
+    // повтор заново строит контейнер, поэтому бюджет считается вместе с подготовкой.
+    int repeats_for(const std::size_t work) {
+        return static_cast<int>(std::clamp<std::size_t>((std::size_t(1) << 22) / std::max<std::size_t>(work, 1), 1, config.max_repeats));
+    }
+
+    // Лучшее время op(state) по повторам; setup() готовит состояние вне замера
+    template <typename Setup, typename Op>
+    double best_ns(Setup&& setup, Op&& op, const int repeats) {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            auto state = setup();
+
+            const auto start = std::chrono::steady_clock::now();
+            op(state);
+            const auto stop = std::chrono::steady_clock::now();
+
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        return best;
+    }
+
+    bool selected(const std::string& container, const char* op) {
+        return config.filter.empty() || (container + "/" + op).find(config.filter) != std::string::npos;
+    }
+
+    void report(const std::string& container, const char* type, const char* op, const std::size_t n, const std::size_t ops, const double ns) {
+        results.push_back({container, type, op, n, ops, ns / ops});
+        std::cout << container << '\t' << type << '\t' << op << '\t' << n << '\t' << ns / ops << " ns/op\n";
+    }
+
+    // work - сколько элементов затрагивают подготовка и сама операция, по нему выбирается число повторов
+    template <typename Setup, typename Op>
+    void measure(const std::string& container, const char* type, const char* op, const std::size_t n, const std::size_t ops,
+                 const std::size_t work, Setup&& setup, Op&& run) {
+        if (!selected(container, op)) {
+            return;
+        }
+
+        report(container, type, op, n, ops, best_ns(setup, run, repeats_for(work)));
+    }
+    /***************************/
+
+
+
+    /***************************/
+    // np::vector и std::vector: одинаковый интерфейс, один шаблон
+    template <typename Vec, typename T>
+    void bench_sequence(const std::string& name, const std::size_t n) {
+        const char* type = type_name<T>;
+        const auto filled = [n] {
+            Vec v;
+            v.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                v.push_back(make_value<T>(i));
+            }
+            return v;
+        };
+
+        measure(name, type, "push_back", n, n, n, [] { return Vec(); }, [n](Vec& v) {
+            for (std::size_t i = 0; i < n; ++i) {
+                v.push_back(make_value<T>(i));
+            }
+            sink = v.size();
+        });
+
+        // Вставка и удаление в середине - O(n) на операцию, число операций ограничено
+        const std::size_t middle_ops = std::clamp<std::size_t>((std::size_t(1) << 24) / n, 1, 64);
+        measure(name, type, "insert", n, middle_ops, n * middle_ops, filled, [&](Vec& v) {
+            for (std::size_t i = 0; i < middle_ops; ++i) {
+                v.insert(v.begin() + static_cast<std::ptrdiff_t>(v.size() / 2), make_value<T>(i));
+            }
+            sink = v.size();
+        });
+
+        measure(name, type, "erase", n, std::min(middle_ops, n), n * middle_ops, filled, [&](Vec& v) {
+            for (std::size_t i = 0, count = std::min(middle_ops, n); i < count; ++i) {
+                v.erase(v.begin() + static_cast<std::ptrdiff_t>(v.size() / 2));
+            }
+            sink = v.size();
+        });
+
+        measure(name, type, "iterate", n, n, 2 * n, filled, [](Vec& v) {
+            std::uint64_t sum = 0;
+            for (const T& value : v) {
+                sum += digest(value);
+            }
+            sink = sum;
+        });
+
+        // Линейный поиск значения из второй половины
+        const std::size_t lookups = std::clamp<std::size_t>((std::size_t(1) << 24) / n, 1, 256);
+        measure(name, type, "lookup", n, lookups, n * lookups, filled, [&](Vec& v) {
+            std::uint64_t found = 0;
+            for (std::size_t i = 0; i < lookups; ++i) {
+                const T needle = make_value<T>(n / 2 + i % (n - n / 2));
+                found += std::find(v.begin(), v.end(), needle) != v.end();
+            }
+            sink = found;
+        });
+
+        measure(name, type, "sort", n, n, n * std::bit_width(n), filled, [](Vec& v) {
+            std::sort(v.begin(), v.end());
+            sink = v.size();
+        });
+    }
+
+    // List и std::list: у List нет константных begin()/end() и splice диапазона, только общее
+    template <typename L, typename T>
+    void bench_list(const std::string& name, const std::size_t n) {
+        const char* type = type_name<T>;
+        const auto filled = [n] {
+            auto list = std::make_unique<L>();
+            for (std::size_t i = 0; i < n; ++i) {
+                list->push_back(make_value<T>(i));
+            }
+            return list;
+        };
+
+        measure(name, type, "push_back", n, n, n, [] { return std::make_unique<L>(); }, [n](std::unique_ptr<L>& list) {
+            for (std::size_t i = 0; i < n; ++i) {
+                list->push_back(make_value<T>(i));
+            }
+            sink = list->size();
+        });
+
+        // Вставка и удаление в одной позиции в середине: сама операция O(1), но в замер входит
+        // проход до этой позиции, одинаковый для List и std::list
+        const std::size_t middle_ops = std::min<std::size_t>(n, 4096);
+        measure(name, type, "insert", n, middle_ops, 2 * n, filled, [&](std::unique_ptr<L>& list) {
+            auto pos = std::next(list->begin(), static_cast<std::ptrdiff_t>(n / 2));
+            for (std::size_t i = 0; i < middle_ops; ++i) {
+                pos = list->insert(pos, make_value<T>(i));
+            }
+            sink = list->size();
+        });
+
+        measure(name, type, "erase", n, middle_ops / 2, 2 * n, filled, [&](std::unique_ptr<L>& list) {
+            auto pos = std::next(list->begin(), static_cast<std::ptrdiff_t>(n / 4));
+            for (std::size_t i = 0; i < middle_ops / 2; ++i) {
+                pos = list->erase(pos);
+            }
+            sink = list->size();
+        });
+
+        measure(name, type, "iterate", n, n, 2 * n, filled, [](std::unique_ptr<L>& list) {
+            std::uint64_t sum = 0;
+            for (const T& value : *list) {
+                sum += digest(value);
+            }
+            sink = sum;
+        });
+
+        const std::size_t lookups = std::clamp<std::size_t>((std::size_t(1) << 22) / n, 1, 64);
+        measure(name, type, "lookup", n, lookups, n * lookups, filled, [&](std::unique_ptr<L>& list) {
+            std::uint64_t found = 0;
+            for (std::size_t i = 0; i < lookups; ++i) {
+                const T needle = make_value<T>(n / 2 + i % (n - n / 2));
+                found += std::find(list->begin(), list->end(), needle) != list->end();
+            }
+            sink = found;
+        });
+
+        if (std::is_same_v<L, std::list<T>> || n <= bubble_sort_limit) {
+            measure(name, type, "sort", n, n, n * std::bit_width(n), filled, [](std::unique_ptr<L>& list) {
+                list->sort();
+                sink = list->size();
+            });
+        }
+    }
+
+    // Map и std::map: вставка случайных ключей и поиск существующих. У Map нет прохода
+    // итератором (нет operator++), он не сравнивается; erase в сравнение не входит.
+    template <typename M, typename T>
+    void bench_map(const std::string& name, const std::size_t n) {
+        const char* type = type_name<T>;
+
+        np::vector<T> keys(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = make_value<T>(i);
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937_64(n));
+
+        const auto filled = [&] {
+            auto map = std::make_unique<M>();
+            for (std::size_t i = 0; i < n; ++i) {
+                map->insert({keys[i], static_cast<int>(i)});
+            }
+            return map;
+        };
+
+        measure(name, type, "insert", n, n, n * std::bit_width(n), [] { return std::make_unique<M>(); }, [&](std::unique_ptr<M>& map) {
+            for (std::size_t i = 0; i < n; ++i) {
+                map->insert({keys[i], static_cast<int>(i)});
+            }
+            sink = map->size();
+        });
+
+        const std::size_t lookups = std::min<std::size_t>(n, std::size_t(1) << 20);
+        measure(name, type, "lookup", n, lookups, (n + lookups) * std::bit_width(n), filled, [&](std::unique_ptr<M>& map) {
+            std::uint64_t found = 0;
+            for (std::size_t i = 0; i < lookups; ++i) {
+                found += map->count(keys[(i * 7919) % n]);
+            }
+            sink = found;
+        });
+    }
+
+    // Handmade::Array и std::array: размер задан типом, поэтому только проход, поиск,
+    // заполнение и сортировка. Массивы лежат в куче - 100M элементов в стек не поместятся.
+    template <typename A, typename T, std::size_t N>
+    void bench_array(const std::string& name) {
+        const char* type = type_name<T>;
+        const auto filled = [] {
+            auto array = std::make_unique<A>();
+            for (std::size_t i = 0; i < N; ++i) {
+                (*array)[i] = make_value<T>(i);
+            }
+            return array;
+        };
+
+        measure(name, type, "fill", N, N, N, [] { return std::make_unique<A>(); }, [](std::unique_ptr<A>& array) {
+            array->fill(make_value<T>(1));
+            sink = digest((*array)[N - 1]);
+        });
+
+        measure(name, type, "iterate", N, N, 2 * N, filled, [](std::unique_ptr<A>& array) {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < N; ++i) {
+                sum += digest((*array)[i]);
+            }
+            sink = sum;
+        });
+
+        const std::size_t lookups = std::clamp<std::size_t>((std::size_t(1) << 24) / N, 1, 256);
+        measure(name, type, "lookup", N, lookups, N * lookups, filled, [&](std::unique_ptr<A>& array) {
+            std::uint64_t found = 0;
+            for (std::size_t i = 0; i < lookups; ++i) {
+                const T needle = make_value<T>(N / 2 + i % (N - N / 2));
+                found += std::find(array->data(), array->data() + N, needle) != array->data() + N;
+            }
+            sink = found;
+        });
+
+        measure(name, type, "sort", N, N, N * std::bit_width(N), filled, [](std::unique_ptr<A>& array) {
+            std::sort(array->data(), array->data() + N);
+            sink = digest((*array)[0]);
+        });
+    }
+    /***************************/
+
+
+
+    /***************************/
+    bool in_range(const std::size_t n) {
+        return n >= config.min_size && n <= config.max_size;
+    }
+
+    template <typename T>
+    void run_type() {
+        for (const std::size_t n : sizes) {
+            if (!in_range(n)) {
+                continue;
+            }
+
+            // Строки и узловые контейнеры на 100M не помещаются в память разумной машины
+            const bool node_sized = n <= node_size_limit;
+            if (std::is_same_v<T, std::string> && !node_sized) {
+                continue;
+            }
+
+            bench_sequence<np::vector<T>, T>("np::vector", n);
+            bench_sequence<std::vector<T>, T>("std::vector", n);
+
+            if (node_sized) {
+                bench_list<List<T>, T>("List", n);
+                bench_list<std::list<T>, T>("std::list", n);
+
+                bench_map<Map<T, int>, T>("Map", n);
+                bench_map<std::map<T, int>, T>("std::map", n);
+            }
+        }
+    }
+
+    template <typename T, std::size_t... Ns>
+    void run_arrays(std::index_sequence<Ns...>) {
+        const auto one = [](auto size) {
+            constexpr std::size_t N = decltype(size)::value;
+            if (in_range(N)) {
+                bench_array<Handmade::Array<T, N>, T, N>("Handmade::Array");
+                bench_array<std::array<T, N>, T, N>("std::array");
+            }
+        };
+
+        (one(std::integral_constant<std::size_t, sizes[Ns]>()), ...);
+    }
+
+    void write_json(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("containers_bench: cannot open " + path);
+        }
+
+        out << "[\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const record& r = results[i];
+            out << "  {\"container\": \"" << r.container << "\", \"type\": \"" << r.type << "\", \"op\": \"" << r.op
+                << "\", \"size\": " << r.size << ", \"ops\": " << r.ops << ", \"ns_per_op\": " << r.ns_per_op << '}'
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "]\n";
+    }
+
+    void parse_options(const int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            const auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(std::string("containers_bench: missing value for ") + argv[i]);
+                }
+                return argv[++i];
+            };
+
+            if (std::strcmp(argv[i], "--min-size") == 0) {
+                config.min_size = std::stoull(value());
+            }
+            else if (std::strcmp(argv[i], "--max-size") == 0) {
+                config.max_size = std::stoull(value());
+            }
+            else if (std::strcmp(argv[i], "--filter") == 0) {
+                config.filter = value();
+            }
+            else if (std::strcmp(argv[i], "--json") == 0) {
+                config.json_path = value();
+            }
+            else if (std::strcmp(argv[i], "--smoke") == 0) {
+                // Быстрый прогон для ctest: только мелкие размеры, по одному замеру
+                config.max_size = std::min<std::size_t>(config.max_size, 4096);
+                config.max_repeats = 1;
+            }
+            else {
+                throw std::invalid_argument(std::string("containers_bench: unknown option ") + argv[i]);
+            }
+        }
+    }
+    /***************************/
+}
+
+int main(int argc, char** argv) {
+    try {
+        parse_options(argc, argv);
+
+        run_type<std::int32_t>();
+        run_type<std::uint64_t>();
+        run_type<double>();
+        run_type<std::string>();
+
+        constexpr auto all_sizes = std::make_index_sequence<std::size(sizes)>();
+        run_arrays<std::int32_t>(all_sizes);
+        run_arrays<std::uint64_t>(all_sizes);
+        run_arrays<double>(all_sizes);
+
+        if (!config.json_path.empty()) {
+            write_json(config.json_path);
+        }
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "../packed_vector/delta_vector.hpp"
+
+// Полный проход с суммированием: np::vector<uint64_t> против packed_vector<34> (итератор и
+// распаковка блоками) и delta_vector на возрастающих отметках времени (индекс и for_each).
+// Рядом - объём каждого представления относительно np::vector.
+
+namespace {
+    template <typename F>
+    double best_ns(F&& f, const int repeats) {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        return best;
+    }
+
+    volatile std::uint64_t sink = 0;
+
+    void report(const char* data, const std::size_t n, const char* impl, const double ns, const double baseline, const std::size_t bytes) {
+        std::cout << data << '\t' << n << '\t' << impl << '\t' << ns / n << " ns/elem\t" << baseline / ns << "x\t"
+                  << static_cast<double>(n * sizeof(std::uint64_t)) / bytes << "x smaller\n";
+    }
+
+    void run_ids(const std::size_t n) {
+        const int repeats = n <= (1u << 20) ? 20 : 3;
+        std::mt19937_64 rng(1);
+
+        np::vector<std::uint64_t> plain(n);
+        np::packed_vector<34> packed;
+        packed.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            plain[i] = rng() & np::packed_vector<34>::max_value;
+            packed.push_back(plain[i]);
+        }
+
+        const double baseline = best_ns([&] {
+            std::uint64_t sum = 0;
+            for (const std::uint64_t value : plain) {
+                sum += value;
+            }
+            sink = sum;
+        }, repeats);
+        report("ids34", n, "vector", baseline, baseline, n * sizeof(std::uint64_t));
+
+        report("ids34", n, "packed iterator", best_ns([&] {
+            std::uint64_t sum = 0;
+            for (const std::uint64_t value : std::as_const(packed)) {
+                sum += value;
+            }
+            sink = sum;
+        }, repeats), baseline, packed.bytes());
+
+        report("ids34", n, "packed unpack", best_ns([&] {
+            std::uint64_t buffer[256];
+            std::uint64_t sum = 0;
+            for (std::size_t first = 0; first < n; first += 256) {
+                const std::size_t count = std::min<std::size_t>(256, n - first);
+                packed.unpack(first, count, buffer);
+                for (std::size_t i = 0; i < count; ++i) {
+                    sum += buffer[i];
+                }
+            }
+            sink = sum;
+        }, repeats), baseline, packed.bytes());
+    }
+
+    void run_timestamps(const std::size_t n) {
+        const int repeats = n <= (1u << 20) ? 20 : 3;
+        std::mt19937_64 rng(2);
+
+        np::vector<std::uint64_t> plain(n);
+        np::delta_vector<> delta;
+        std::uint64_t now = 1'700'000'000'000'000ull;
+        for (std::size_t i = 0; i < n; ++i) {
+            now += rng() % 4096;
+            plain[i] = now;
+            delta.push_back(now);
+        }
+        delta.shrink_to_fit();
+
+        const double baseline = best_ns([&] {
+            std::uint64_t sum = 0;
+            for (const std::uint64_t value : plain) {
+                sum += value;
+            }
+            sink = sum;
+        }, repeats);
+        report("timestamps", n, "vector", baseline, baseline, n * sizeof(std::uint64_t));
+
+        report("timestamps", n, "delta index", best_ns([&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += delta[i];
+            }
+            sink = sum;
+        }, repeats), baseline, delta.bytes());
+
+        report("timestamps", n, "delta for_each", best_ns([&] {
+            std::uint64_t sum = 0;
+            delta.for_each([&](const std::uint64_t value) { sum += value; });
+            sink = sum;
+        }, repeats), baseline, delta.bytes());
+    }
+}
+
+int main() {
+    for (const std::size_t n : {std::size_t(1) << 16, std::size_t(1) << 20, std::size_t(1) << 26}) {
+        run_ids(n);
+        run_timestamps(n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#include "../vector/rank_select.hpp"
+
+// rank1 / select1 через np::rank_select против прямого подсчёта popcount по словам от начала.
+// Позиции запросов случайные, так что прямой подсчёт в среднем проходит половину вектора.
+
+namespace {
+    template <typename F>
+    double best_ns(F&& f, const int repeats) {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        return best;
+    }
+
+    volatile std::size_t sink = 0;
+
+    std::size_t naive_rank1(const np::vector<bool>& bits, const std::size_t pos) {
+        const std::uint64_t* words = bits.words().data();
+        std::size_t result = np::simd::popcount(words, pos / 64);
+        if (pos % 64 != 0) {
+            result += static_cast<std::size_t>(std::popcount(words[pos / 64] & ((std::uint64_t(1) << (pos % 64)) - 1)));
+        }
+
+        return result;
+    }
+
+    std::size_t naive_select1(const np::vector<bool>& bits, std::size_t k) {
+        const std::span<const std::uint64_t> words = bits.words();
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            const std::size_t count = static_cast<std::size_t>(std::popcount(words[i]));
+            if (k < count) {
+                return i * 64 + np::simd::select_in_word(words[i], static_cast<unsigned>(k));
+            }
+            k -= count;
+        }
+
+        return np::vector<bool>::npos;
+    }
+
+    void report(const std::size_t n, const double density, const char* op, const char* impl, const double ns, const std::size_t queries, const double baseline) {
+        std::cout << n << '\t' << density << '\t' << op << '\t' << impl << '\t'
+                  << ns / queries << " ns/query\t" << baseline / ns << "x\n";
+    }
+
+    void run(const std::size_t n, const double density) {
+        std::mt19937_64 rng(42);
+        std::bernoulli_distribution bit(density);
+
+        np::vector<bool> bits;
+        bits.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            bits.push_back(bit(rng));
+        }
+
+        const double build = best_ns([&] { np::rank_select<> index(bits); sink = index.count_ones(); }, 3);
+        const np::rank_select<> index(bits);
+
+        std::cout << n << '\t' << density << "\tbuild\t" << build / n << " ns/bit\toverhead "
+                  << 100.0 * index.directory_bytes() / (bits.words().size() * sizeof(std::uint64_t)) << "%\n";
+
+        constexpr std::size_t fast_queries = 1 << 20;
+        const std::size_t naive_queries = std::max<std::size_t>(16, (std::size_t(1) << 30) / n);
+
+        np::vector<std::size_t> positions(fast_queries);
+        np::vector<std::size_t> ranks(fast_queries);
+        for (std::size_t i = 0; i < fast_queries; ++i) {
+            positions[i] = rng() % (n + 1);
+            ranks[i] = index.count_ones() == 0 ? 0 : rng() % index.count_ones();
+        }
+
+        const double naive_rank = best_ns([&] {
+            for (std::size_t i = 0; i < naive_queries; ++i) {
+                sink = naive_rank1(bits, positions[i]);
+            }
+        }, 3) / naive_queries;
+        report(n, density, "rank1", "naive", naive_rank * fast_queries, fast_queries, naive_rank * fast_queries);
+        report(n, density, "rank1", "index", best_ns([&] {
+            for (std::size_t i = 0; i < fast_queries; ++i) {
+                sink = index.rank1(positions[i]);
+            }
+        }, 3), fast_queries, naive_rank * fast_queries);
+
+        const double naive_select = best_ns([&] {
+            for (std::size_t i = 0; i < naive_queries; ++i) {
+                sink = naive_select1(bits, ranks[i]);
+            }
+        }, 3) / naive_queries;
+        report(n, density, "select1", "naive", naive_select * fast_queries, fast_queries, naive_select * fast_queries);
+        report(n, density, "select1", "index", best_ns([&] {
+            for (std::size_t i = 0; i < fast_queries; ++i) {
+                sink = index.select1(ranks[i]);
+            }
+        }, 3), fast_queries, naive_select * fast_queries);
+    }
+}
+
+int main() {
+    for (const std::size_t n : {std::size_t(1) << 16, std::size_t(1) << 24, std::size_t(1) << 30}) {
+        for (const double density : {0.5, 0.01}) {
+            run(n, density);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "../vector/vector.hpp"
+
+// Сравнение SIMD-ядер find / count / operator== с обычным циклом по итераторам np::vector.
+// Искомое значение лежит в последнем элементе, так что просматривается весь буфер.
+
+namespace {
+    template <typename F>
+    double best_ns(F&& f, const int repeats) {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            f();
+            const auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        return best;
+    }
+
+    volatile std::size_t sink = 0;
+
+    void report(const std::string& type, const std::size_t n, const char* op, const char* impl, const double ns, const double baseline) {
+        std::cout << type << '\t' << n << '\t' << op << '\t' << impl << '\t'
+                  << ns / n << " ns/elem\t" << baseline / ns << "x\n";
+    }
+
+    template <typename T>
+    void run(const std::string& type, const std::size_t n) {
+        const int repeats = n <= 4096 ? 2000 : n <= (1u << 20) ? 50 : 5;
+
+        np::vector<T> haystack(n, T(1));
+        haystack[n - 1] = T(2);
+        np::vector<T> copy = haystack;
+        const T needle = T(2);
+
+        const double generic_find = best_ns([&] { sink = std::find(haystack.begin(), haystack.end(), needle) - haystack.begin(); }, repeats);
+        report(type, n, "find", "generic", generic_find, generic_find);
+        report(type, n, "find", "dispatch", best_ns([&] { sink = np::find(haystack, needle) - haystack.begin(); }, repeats), generic_find);
+        report(type, n, "find", "scalar", best_ns([&] { sink = np::simd::detail::find_scalar(haystack.data(), n, needle); }, repeats), generic_find);
+#if NP_SIMD_X86
+        report(type, n, "find", "sse2", best_ns([&] { sink = np::simd::detail::find_sse2(haystack.data(), n, needle); }, repeats), generic_find);
+        if (np::simd::active_isa() >= np::simd::isa::avx2) {
+            report(type, n, "find", "avx2", best_ns([&] { sink = np::simd::detail::find_avx2(haystack.data(), n, needle); }, repeats), generic_find);
+        }
+        if (np::simd::active_isa() >= np::simd::isa::avx512) {
+            report(type, n, "find", "avx512", best_ns([&] { sink = np::simd::detail::find_avx512(haystack.data(), n, needle); }, repeats), generic_find);
+        }
+#endif
+
+        const double generic_count = best_ns([&] { sink = std::count(haystack.begin(), haystack.end(), needle); }, repeats);
+        report(type, n, "count", "generic", generic_count, generic_count);
+        report(type, n, "count", "dispatch", best_ns([&] { sink = np::count(haystack, needle); }, repeats), generic_count);
+
+        const double generic_equal = best_ns([&] { sink = std::equal(haystack.begin(), haystack.end(), copy.begin()); }, repeats);
+        report(type, n, "equal", "generic", generic_equal, generic_equal);
+        report(type, n, "equal", "dispatch", best_ns([&] { sink = haystack == copy; }, repeats), generic_equal);
+    }
+}
+
+int main() {
+    static const char* isa_names[] = {"scalar", "sse2", "avx2", "avx512"};
+    std::cout << "active isa: " << isa_names[static_cast<int>(np::simd::active_isa())] << '\n';
+
+    for (const std::size_t n : {std::size_t(4096), std::size_t(1) << 20, std::size_t(1) << 24}) {
+        run<std::int32_t>("int32", n);
+        run<float>("float", n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,605 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace np {
+    // Вектор с конкурентным добавлением. Элементы лежат в корзинах, каждая следующая вдвое больше
+    // предыдущей: корзина k вмещает first_bucket << k элементов. Место под новый элемент занимается
+    // CAS по счётчику после того, как его корзина уже есть; корзина создаётся первым дошедшим до неё
+    // потоком тоже через CAS. Уже добавленные элементы никогда не перемещаются, так что указатели и
+    // ссылки на них остаются валидными.
+    //
+    // push_back/emplace_back/reserve, чтение и обращение по индексу безопасны одновременно.
+    // У каждого места есть байт состояния. size() и end() видят только опубликованный префикс:
+    // все элементы [0, size()) уже построены, так что параллельный обход не читает сырую память.
+    // Элемент, построенный раньше предшественников, становится виден, когда достроятся и они.
+    // Если конструктор бросил, место возвращается: последнее - сразу через счётчик, иначе его
+    // занимает следующий push_back, а до тех пор публикация на нём стоит.
+    // Остальные операции (копирование, clear, swap) требуют монопольного доступа.
+    template <typename T, typename Allocator = std::allocator<T>>
+    class concurrent_vector {
+        using allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+        using allocator_type = Allocator;
+        using value_type = T;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = typename allocator_traits::pointer;
+        using const_pointer = typename allocator_traits::const_pointer;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+    private:
+        static_assert(std::is_pointer_v<pointer>, "buckets are published through std::atomic<pointer>");
+
+        // Состояние места: занято и строится (или свободно), построено, конструктор бросил
+        enum slot_state : unsigned char { slot_empty, slot_ready, slot_failed };
+
+        using state_type = std::atomic<unsigned char>;
+        using state_allocator = typename allocator_traits::template rebind_alloc<state_type>;
+        using state_traits = std::allocator_traits<state_allocator>;
+        using state_pointer = typename state_traits::pointer;
+
+        static_assert(std::is_pointer_v<state_pointer>, "slot states are published through std::atomic<state_pointer>");
+
+        static constexpr size_type first_bucket_bits_ = 5;
+        static constexpr size_type first_bucket_ = size_type(1) << first_bucket_bits_;
+        static constexpr std::size_t cache_line_ = 64;
+        static constexpr size_type bucket_count_ = std::numeric_limits<size_type>::digits - first_bucket_bits_;
+
+        template <bool is_const>
+        class base_iterator {
+            using owner_type = std::conditional_t<is_const, const concurrent_vector, concurrent_vector>;
+
+        public:
+            using pointer_type = std::conditional_t<is_const, const_pointer, pointer>;
+            using reference_type = std::conditional_t<is_const, const_reference, reference>;
+            using difference_type = std::ptrdiff_t;
+            using value_type = T;
+            using iterator_category = std::random_access_iterator_tag;
+
+            owner_type* owner_ = nullptr;
+            size_type index_ = 0;
+
+            /***************************/
+            base_iterator() noexcept = default;
+
+            base_iterator(owner_type* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+
+            // iterator -> const_iterator
+            template <bool other_const> requires (is_const && !other_const)
+            base_iterator(const base_iterator<other_const>& other) noexcept : owner_(other.owner_), index_(other.index_) {}
+            /***************************/
+
+
+            /***************************/
+            reference_type operator*() const {
+                return (*owner_)[index_];
+            }
+
+            pointer_type operator->() const {
+                return std::addressof((*owner_)[index_]);
+            }
+
+            reference_type operator[](const difference_type offset) const {
+                return (*owner_)[index_ + offset];
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+
+            base_iterator& operator--() {
+                --index_;
+                return *this;
+            }
+
+            base_iterator operator++(int) {
+                base_iterator temp = *this;
+                ++index_;
+                return temp;
+            }
+
+            base_iterator operator--(int) {
+                base_iterator temp = *this;
+                --index_;
+                return temp;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator operator+(const difference_type value) const {
+                return base_iterator(owner_, index_ + value);
+            }
+
+            friend base_iterator operator+(const difference_type value, const base_iterator& it) {
+                return it + value;
+            }
+
+            base_iterator operator-(const difference_type value) const {
+                return base_iterator(owner_, index_ - value);
+            }
+
+            difference_type operator-(const base_iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            base_iterator& operator+=(const difference_type value) {
+                index_ += value;
+                return *this;
+            }
+
+            base_iterator& operator-=(const difference_type value) {
+                index_ -= value;
+                return *this;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            bool operator==(const base_iterator& other) const {
+                return index_ == other.index_;
+            }
+
+            auto operator<=>(const base_iterator& other) const {
+                return index_ <=> other.index_;
+            }
+            /***************************/
+        };
+
+    public:
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    public:
+        concurrent_vector() noexcept = default;
+
+        explicit concurrent_vector(const allocator_type& alloc) noexcept : allocator_(alloc) {}
+
+        concurrent_vector(const std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) : allocator_(alloc) {
+            reserve(list.size());
+            for (const auto& value : list) {
+                push_back(value);
+            }
+        }
+
+        concurrent_vector(const concurrent_vector& other) : allocator_(allocator_traits::select_on_container_copy_construction(other.allocator_)) {
+            const size_type count = other.size();
+            reserve(count);
+            for (size_type index = 0; index < count; ++index) {
+                push_back(other[index]);
+            }
+        }
+
+        concurrent_vector(concurrent_vector&& other) noexcept : allocator_(std::move(other.allocator_)) {
+            steal_(other);
+        }
+
+        concurrent_vector& operator=(const concurrent_vector& other) {
+            if (this != &other) {
+                if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+                    // Корзины выделены старым аллокатором - вернуть их ему, пока он ещё наш
+                    if (allocator_ != other.allocator_) {
+                        release_();
+                    }
+
+                    allocator_ = other.allocator_;
+                }
+
+                assign_(other.size(), [&other](const size_type index) -> const_reference { return other[index]; });
+            }
+
+            return *this;
+        }
+
+        concurrent_vector& operator=(concurrent_vector&& other) noexcept(allocator_traits::propagate_on_container_move_assignment::value
+                                                                         || allocator_traits::is_always_equal::value) {
+            if (this != &other) {
+                if constexpr (!allocator_traits::propagate_on_container_move_assignment::value && !allocator_traits::is_always_equal::value) {
+                    // Аллокатор остаётся свой, и если он не равен чужому - перемещаем поэлементно
+                    if (allocator_ != other.allocator_) {
+                        assign_(other.size(), [&other](const size_type index) -> value_type&& { return std::move(other[index]); });
+                        other.clear();
+                        return *this;
+                    }
+                }
+
+                release_();
+
+                if constexpr (allocator_traits::propagate_on_container_move_assignment::value) {
+                    allocator_ = std::move(other.allocator_);
+                }
+
+                steal_(other);
+            }
+
+            return *this;
+        }
+
+        ~concurrent_vector() {
+            release_();
+        }
+
+        void swap(concurrent_vector& other) noexcept {
+            if constexpr (allocator_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap(allocator_, other.allocator_);
+            }
+
+            const auto exchange = [](auto& lhs, auto& rhs) {
+                lhs.store(rhs.exchange(lhs.load(std::memory_order_relaxed), std::memory_order_relaxed), std::memory_order_relaxed);
+            };
+
+            for (size_type bucket = 0; bucket < bucket_count_; ++bucket) {
+                exchange(buckets_[bucket], other.buckets_[bucket]);
+                exchange(states_[bucket], other.states_[bucket]);
+            }
+            exchange(claimed_, other.claimed_);
+            exchange(holes_, other.holes_);
+            exchange(size_, other.size_);
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_;
+        }
+
+        // Заранее создаёт корзины под count элементов, чтобы добавление не упиралось в аллокацию
+        void reserve(const size_type count) {
+            if (count == 0) {
+                return;
+            }
+
+            const size_type last = locate_(count - 1).first;
+            for (size_type bucket = 0; bucket <= last; ++bucket) {
+                bucket_(bucket);
+            }
+        }
+
+        iterator push_back(const_reference value) {
+            const size_type index = claim_();
+            construct_at_(index, value);
+            return iterator(this, index);
+        }
+
+        iterator push_back(value_type&& value) {
+            const size_type index = claim_();
+            construct_at_(index, std::move(value));
+            return iterator(this, index);
+        }
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args) {
+            const size_type index = claim_();
+            return construct_at_(index, std::forward<Args>(args)...);
+        }
+
+        void clear() noexcept {
+            destroy_elements_();
+        }
+
+        // Освобождает корзины, не занятые элементами
+        void shrink_to_fit() noexcept {
+            const size_type count = claimed_.load(std::memory_order_relaxed);
+            const size_type keep = count == 0 ? 0 : locate_(count - 1).first + 1;
+
+            state_allocator state_alloc(allocator_);
+            for (size_type bucket = keep; bucket < bucket_count_; ++bucket) {
+                if (pointer ptr = buckets_[bucket].exchange(nullptr, std::memory_order_relaxed)) {
+                    allocator_traits::deallocate(allocator_, ptr, bucket_size_(bucket));
+                }
+                if (state_pointer states = states_[bucket].exchange(nullptr, std::memory_order_relaxed)) {
+                    state_traits::deallocate(state_alloc, states, bucket_size_(bucket));
+                }
+            }
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return size_.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept {
+            size_type total = 0;
+            for (size_type bucket = 0; bucket < bucket_count_ && buckets_[bucket].load(std::memory_order_acquire); ++bucket) {
+                total += bucket_size_(bucket);
+            }
+
+            return total;
+        }
+
+        [[nodiscard]] size_type max_size() const noexcept {
+            return std::min<size_type>(allocator_traits::max_size(allocator_), std::numeric_limits<difference_type>::max());
+        }
+
+        reference operator[](const size_type index) noexcept {
+            const auto [bucket, offset] = locate_(index);
+            return buckets_[bucket].load(std::memory_order_acquire)[offset];
+        }
+
+        const_reference operator[](const size_type index) const noexcept {
+            const auto [bucket, offset] = locate_(index);
+            return buckets_[bucket].load(std::memory_order_acquire)[offset];
+        }
+
+        reference at(const size_type index) {
+            if (index >= size()) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return (*this)[index];
+        }
+
+        const_reference at(const size_type index) const {
+            if (index >= size()) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return (*this)[index];
+        }
+
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+
+        reference back() { return (*this)[size() - 1]; }
+        const_reference back() const { return (*this)[size() - 1]; }
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(this, size()); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+
+    private:
+        static constexpr size_type bucket_size_(const size_type bucket) noexcept {
+            return first_bucket_ << bucket;
+        }
+
+        // Индекс -> (корзина, смещение): index + first_bucket_ в корзине k лежит в [first_bucket_ << k, first_bucket_ << (k + 1))
+        static constexpr std::pair<size_type, size_type> locate_(const size_type index) noexcept {
+            const size_type biased = index + first_bucket_;
+            const size_type bucket = static_cast<size_type>(std::bit_width(biased)) - 1 - first_bucket_bits_;
+            return {bucket, biased - bucket_size_(bucket)};
+        }
+
+        // Место занимается CAS по claimed_ только когда его корзина уже выделена: если allocate бросит,
+        // счётчик не тронут и destroy_elements_ не наткнётся на слот без корзины.
+        // Сначала - места, освобождённые бросившими конструкторами
+        size_type claim_() {
+            if (holes_.load(std::memory_order_relaxed) != 0) {
+                if (const std::optional<size_type> hole = take_hole_()) {
+                    return *hole;
+                }
+            }
+
+            size_type index = claimed_.load(std::memory_order_relaxed);
+            do {
+                if (index >= max_size()) {
+                    throw std::length_error("concurrent_vector: max_size exceeded");
+                }
+
+                bucket_(locate_(index).first);
+            } while (!claimed_.compare_exchange_weak(index, index + 1, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+            return index;
+        }
+
+        // Дыры лежат между опубликованным префиксом и claimed_: ниже size_ все места построены
+        std::optional<size_type> take_hole_() noexcept {
+            const size_type end = claimed_.load(std::memory_order_seq_cst);
+            for (size_type index = size_.load(std::memory_order_acquire); index < end; ++index) {
+                unsigned char expected = slot_failed;
+                if (state_(index).compare_exchange_strong(expected, slot_empty, std::memory_order_relaxed)) {
+                    holes_.fetch_sub(1, std::memory_order_relaxed);
+                    return index;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        // Корзина создаётся тем потоком, который первым до неё дошёл; проигравший гонку отдаёт свою.
+        // Байты состояний публикуются раньше элементов: кто видит корзину, видит и их
+        pointer bucket_(const size_type bucket) {
+            pointer ptr = buckets_[bucket].load(std::memory_order_acquire);
+            if (ptr != nullptr) {
+                return ptr;
+            }
+
+            states_of_(bucket);
+
+            pointer fresh = allocator_traits::allocate(allocator_, bucket_size_(bucket));
+            if (buckets_[bucket].compare_exchange_strong(ptr, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return fresh;
+            }
+
+            allocator_traits::deallocate(allocator_, fresh, bucket_size_(bucket));
+            return ptr;
+        }
+
+        state_pointer states_of_(const size_type bucket) {
+            state_pointer states = states_[bucket].load(std::memory_order_acquire);
+            if (states != nullptr) {
+                return states;
+            }
+
+            state_allocator state_alloc(allocator_);
+            state_pointer fresh = state_traits::allocate(state_alloc, bucket_size_(bucket));
+            for (size_type offset = 0; offset < bucket_size_(bucket); ++offset) {
+                state_traits::construct(state_alloc, fresh + offset, slot_empty);
+            }
+
+            if (states_[bucket].compare_exchange_strong(states, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return fresh;
+            }
+
+            state_traits::deallocate(state_alloc, fresh, bucket_size_(bucket));
+            return states;
+        }
+
+        state_type& state_(const size_type index) const noexcept {
+            const auto [bucket, offset] = locate_(index);
+            return states_[bucket].load(std::memory_order_acquire)[offset];
+        }
+
+        // Корзину claim_ уже выделил, здесь она только читается. Если конструктор бросил, место
+        // отдаётся обратно и в size() не попадает
+        template <typename... Args>
+        reference construct_at_(const size_type index, Args&&... args) {
+            const auto [bucket, offset] = locate_(index);
+            pointer slot = buckets_[bucket].load(std::memory_order_acquire) + offset;
+
+            try {
+                allocator_traits::construct(allocator_, slot, std::forward<Args>(args)...);
+            } catch (...) {
+                give_back_(index);
+                throw;
+            }
+
+            state_(index).store(slot_ready, std::memory_order_seq_cst);
+            publish_();
+            return *slot;
+        }
+
+        // Последнее занятое место просто снимается со счётчика, иначе остаётся дырой для claim_
+        void give_back_(size_type index) noexcept {
+            size_type last = index + 1;
+            if (claimed_.compare_exchange_strong(last, index, std::memory_order_seq_cst)) {
+                return;
+            }
+
+            state_(index).store(slot_failed, std::memory_order_seq_cst);
+            holes_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Продвигает size_ по подряд построенным местам. Продвигать может любой поток: тот, кто
+        // достроил место раньше предшественника, уходит, и префикс дотягивает достроивший последним.
+        // Состояния и счётчики - seq_cst, чтобы два таких потока не разминулись
+        void publish_() noexcept {
+            size_type published = size_.load(std::memory_order_seq_cst);
+            while (published < claimed_.load(std::memory_order_seq_cst) && state_(published).load(std::memory_order_seq_cst) == slot_ready) {
+                if (size_.compare_exchange_weak(published, published + 1, std::memory_order_seq_cst)) {
+                    ++published;
+                }
+            }
+        }
+
+        // Поэлементное присваивание: живые элементы присваиваются, недостающие добавляются, лишние разрушаются.
+        // Построенные, но не опубликованные элементы и дыры сюда не доживают
+        template <typename Get>
+        void assign_(const size_type count, Get get) {
+            if (claimed_.load(std::memory_order_relaxed) != size_.load(std::memory_order_relaxed)) {
+                clear();
+            }
+
+            size_type current = size_.load(std::memory_order_relaxed);
+            while (current > count) {
+                allocator_traits::destroy(allocator_, std::addressof((*this)[--current]));
+                state_(current).store(slot_empty, std::memory_order_relaxed);
+                claimed_.store(current, std::memory_order_relaxed);
+                size_.store(current, std::memory_order_relaxed);
+            }
+
+            for (size_type index = 0; index < current; ++index) {
+                (*this)[index] = get(index);
+            }
+
+            reserve(count);
+            for (size_type index = current; index < count; ++index) {
+                emplace_back(get(index));
+            }
+        }
+
+        // Разрушает построенные элементы, в том числе ещё не опубликованные, и сбрасывает состояния мест
+        void destroy_elements_() noexcept {
+            size_type remaining = claimed_.load(std::memory_order_relaxed);
+            for (size_type bucket = 0; remaining != 0; ++bucket) {
+                const size_type count = std::min(remaining, bucket_size_(bucket));
+                pointer ptr = buckets_[bucket].load(std::memory_order_relaxed);
+                state_pointer states = states_[bucket].load(std::memory_order_relaxed);
+
+                for (size_type offset = 0; offset < count; ++offset) {
+                    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                        if (states[offset].load(std::memory_order_relaxed) == slot_ready) {
+                            allocator_traits::destroy(allocator_, ptr + offset);
+                        }
+                    }
+                    states[offset].store(slot_empty, std::memory_order_relaxed);
+                }
+                remaining -= count;
+            }
+
+            claimed_.store(0, std::memory_order_relaxed);
+            holes_.store(0, std::memory_order_relaxed);
+            size_.store(0, std::memory_order_relaxed);
+        }
+
+        void release_() noexcept {
+            destroy_elements_();
+            shrink_to_fit();
+        }
+
+        void steal_(concurrent_vector& other) noexcept {
+            const auto take = [](auto& lhs, auto& rhs, const auto empty) {
+                lhs.store(rhs.exchange(empty, std::memory_order_relaxed), std::memory_order_relaxed);
+            };
+
+            for (size_type bucket = 0; bucket < bucket_count_; ++bucket) {
+                take(buckets_[bucket], other.buckets_[bucket], pointer(nullptr));
+                take(states_[bucket], other.states_[bucket], state_pointer(nullptr));
+            }
+            take(claimed_, other.claimed_, size_type(0));
+            take(holes_, other.holes_, size_type(0));
+            take(size_, other.size_, size_type(0));
+        }
+
+        // Счётчики на отдельных строках кэша: claimed_ дёргают пишущие потоки при захвате места, size_ - при
+        // публикации и читатели; таблицы корзин и состояний в основном читают
+        alignas(cache_line_) std::atomic<size_type> claimed_ = 0;
+        std::atomic<size_type> holes_ = 0;
+        alignas(cache_line_) std::atomic<size_type> size_ = 0;
+        alignas(cache_line_) std::atomic<pointer> buckets_[bucket_count_] = {};
+        std::atomic<state_pointer> states_[bucket_count_] = {};
+        [[no_unique_address]] allocator_type allocator_;
+    };
+
+    template <typename T, typename Allocator>
+    void swap(concurrent_vector<T, Allocator>& lhs, concurrent_vector<T, Allocator>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "../vector/vector.hpp"
+
+namespace np {
+    template <typename T, typename Allocator>
+    class atomic_cow_vector;
+
+    // Вектор с копированием при записи поверх общего np::vector со счётчиком ссылок (shared_ptr).
+    // Копия cow_vector - O(1) снимок: оба объекта смотрят на один буфер. Первая изменяющая
+    // операция над разделяемым буфером копирует его, следующие идут на месте.
+    //
+    // Сам объект, как и shared_ptr, не потокобезопасен: каждый поток работает со своей копией.
+    // Для публикации между потоками - atomic_cow_vector ниже.
+    template <typename T, typename Allocator = std::allocator<T>>
+    class cow_vector {
+    public:
+        using buffer_type = vector<T, Allocator>;
+
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_reference = const T&;
+        using const_pointer = typename buffer_type::const_pointer;
+
+        // Через итераторы только читаем: изменение - edit() или методы ниже
+        using const_iterator = typename buffer_type::const_iterator;
+        using iterator = const_iterator;
+        using const_reverse_iterator = typename buffer_type::const_reverse_iterator;
+        using reverse_iterator = const_reverse_iterator;
+
+        cow_vector() noexcept = default;
+
+        explicit cow_vector(const allocator_type& alloc) : allocator_(alloc) {}
+
+        cow_vector(const size_type n, const T& value, const allocator_type& alloc = allocator_type())
+            : buffer_(make_buffer_(alloc, n, value, alloc)), allocator_(alloc) {}
+
+        cow_vector(const std::initializer_list<T> list, const allocator_type& alloc = allocator_type())
+            : buffer_(make_buffer_(alloc, list, alloc)), allocator_(alloc) {}
+
+        template <std::input_iterator InputIt>
+        cow_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type())
+            : buffer_(make_buffer_(alloc, first, last, alloc)), allocator_(alloc) {}
+
+        // Забирает готовый вектор без копирования элементов
+        explicit cow_vector(buffer_type&& items)
+            : buffer_(make_buffer_(items.get_allocator(), std::move(items))), allocator_(buffer_->get_allocator()) {}
+
+        cow_vector(const cow_vector&) noexcept = default;
+        cow_vector(cow_vector&&) noexcept = default;
+
+        cow_vector& operator=(const cow_vector&) noexcept = default;
+        cow_vector& operator=(cow_vector&&) noexcept = default;
+
+        ~cow_vector() = default;
+
+        void swap(cow_vector& other) noexcept {
+            buffer_.swap(other.buffer_);
+            std::swap(allocator_, other.allocator_);
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept {
+            return allocator_;
+        }
+
+        /***************************/
+        // Чтение - из общего буфера, без копирования
+        [[nodiscard]] const buffer_type& items() const noexcept {
+            return buffer_ ? *buffer_ : empty_();
+        }
+
+        const_iterator begin() const noexcept { return items().begin(); }
+        const_iterator cbegin() const noexcept { return items().cbegin(); }
+
+        const_iterator end() const noexcept { return items().end(); }
+        const_iterator cend() const noexcept { return items().cend(); }
+
+        const_reverse_iterator rbegin() const noexcept { return items().rbegin(); }
+        const_reverse_iterator crbegin() const noexcept { return items().crbegin(); }
+
+        const_reverse_iterator rend() const noexcept { return items().rend(); }
+        const_reverse_iterator crend() const noexcept { return items().crend(); }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return buffer_ ? buffer_->size() : 0;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        const_reference operator[](const size_type index) const {
+            return (*buffer_)[index];
+        }
+
+        const_reference at(const size_type index) const {
+            return items().at(index);
+        }
+
+        const_reference front() const { return (*buffer_)[0]; }
+        const_reference back() const { return (*buffer_)[buffer_->size() - 1]; }
+
+        const_pointer data() const { return items().data(); }
+
+        // Число cow_vector (и опубликованных значений), разделяющих буфер
+        [[nodiscard]] long use_count() const noexcept {
+            return buffer_.use_count();
+        }
+
+        [[nodiscard]] bool shares_buffer_with(const cow_vector& other) const noexcept {
+            return buffer_ != nullptr && buffer_ == other.buffer_;
+        }
+        /***************************/
+
+
+
+        /***************************/
+        // Изменяемый доступ к буферу; разделяемый буфер перед этим копируется. Ссылка действительна
+        // до следующей копии этого cow_vector - потом первая запись снова начнётся с копирования.
+        buffer_type& edit() {
+            if (!buffer_) {
+                buffer_ = make_buffer_(allocator_, allocator_);
+            }
+            else if (buffer_.use_count() != 1) {
+                buffer_ = make_buffer_(allocator_, *buffer_);
+            }
+            else {
+                // Последний читатель мог отпустить буфер только что: его чтения должны
+                // завершиться до наших записей
+                std::atomic_thread_fence(std::memory_order_acquire);
+            }
+
+            return *buffer_;
+        }
+
+        void set(const size_type index, const T& value) {
+            edit()[index] = value;
+        }
+
+        void set(const size_type index, T&& value) {
+            edit()[index] = std::move(value);
+        }
+
+        void push_back(const T& value) {
+            edit().push_back(value);
+        }
+
+        void push_back(T&& value) {
+            edit().push_back(std::move(value));
+        }
+
+        template <typename... Args>
+        void emplace_back(Args&&... args) {
+            edit().emplace_back(std::forward<Args>(args)...);
+        }
+
+        void pop_back() {
+            edit().pop_back();
+        }
+
+        void resize(const size_type count) {
+            edit().resize(count);
+        }
+
+        void resize(const size_type count, const T& value) {
+            edit().resize(count, value);
+        }
+
+        void reserve(const size_type new_capacity) {
+            edit().reserve(new_capacity);
+        }
+
+        // Разделяемый буфер не копируется, а просто отпускается
+        void clear() noexcept {
+            if (buffer_ && buffer_.use_count() == 1) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                buffer_->clear();
+            }
+            else {
+                buffer_.reset();
+            }
+        }
+        /***************************/
+
+        friend bool operator==(const cow_vector& lhs, const cow_vector& rhs) {
+            return lhs.buffer_ == rhs.buffer_ || lhs.items() == rhs.items();
+        }
+
+    private:
+        friend class atomic_cow_vector<T, Allocator>;
+
+        using buffer_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<buffer_type>;
+
+        cow_vector(std::shared_ptr<buffer_type> buffer, const allocator_type& alloc) noexcept : buffer_(std::move(buffer)), allocator_(alloc) {}
+
+        // Блок управления и сам объект вектора - одним выделением через тот же аллокатор
+        template <typename... Args>
+        static std::shared_ptr<buffer_type> make_buffer_(const allocator_type& alloc, Args&&... args) {
+            return std::allocate_shared<buffer_type>(buffer_allocator(alloc), std::forward<Args>(args)...);
+        }
+
+        static const buffer_type& empty_() noexcept {
+            static const buffer_type empty;
+            return empty;
+        }
+
+        std::shared_ptr<buffer_type> buffer_;
+        [[no_unique_address]] allocator_type allocator_;
+    };
+
+    // Точка публикации cow_vector между потоками. load() - O(1) снимок для читателя, store()
+    // публикует новую версию одной атомарной заменой указателя; старые снимки остаются целыми,
+    // пока их держат читатели. Писатель берёт load(), меняет свою копию (копируется один раз,
+    // при первой записи) и делает store(); несколько писателей - через update().
+    //
+    // Основа - std::atomic<std::shared_ptr>: в libstdc++ он не lock-free (короткая спин-блокировка
+    // на бит указателя), но читатели не ждут писателя дольше одной замены указателя.
+    template <typename T, typename Allocator = std::allocator<T>>
+    class atomic_cow_vector {
+    public:
+        using value_type = cow_vector<T, Allocator>;
+
+        atomic_cow_vector() noexcept = default;
+
+        explicit atomic_cow_vector(value_type initial) : current_(std::move(initial.buffer_)), allocator_(initial.allocator_) {}
+
+        atomic_cow_vector(const atomic_cow_vector&) = delete;
+        atomic_cow_vector& operator=(const atomic_cow_vector&) = delete;
+
+        [[nodiscard]] value_type load(const std::memory_order order = std::memory_order_acquire) const noexcept {
+            return value_type(current_.load(order), allocator_);
+        }
+
+        void store(value_type next, const std::memory_order order = std::memory_order_release) noexcept {
+            current_.store(std::move(next.buffer_), order);
+        }
+
+        value_type exchange(value_type next, const std::memory_order order = std::memory_order_acq_rel) noexcept {
+            return value_type(current_.exchange(std::move(next.buffer_), order), allocator_);
+        }
+
+        // Публикует desired, если с expected ничего не менялось; иначе expected - текущая версия
+        bool compare_exchange(value_type& expected, value_type desired) noexcept {
+            return current_.compare_exchange_strong(expected.buffer_, std::move(desired.buffer_), std::memory_order_acq_rel, std::memory_order_acquire);
+        }
+
+        // fn(cow_vector&) применяется к свежему снимку, пока публикация не пройдёт без гонки
+        template <typename Fn>
+        value_type update(Fn fn) {
+            value_type expected = load();
+            for (;;) {
+                value_type next = expected;
+                fn(next);
+
+                if (compare_exchange(expected, next)) {
+                    return next;
+                }
+            }
+        }
+
+    private:
+        std::atomic<std::shared_ptr<typename value_type::buffer_type>> current_;
+        [[no_unique_address]] Allocator allocator_;
+    };
+}
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/vector.hpp"
+
+namespace np {
+    // Метка для вставки диапазона, уже отсортированного по ключу и без повторов
+    struct sorted_unique_t {
+        explicit sorted_unique_t() = default;
+    };
+
+    inline constexpr sorted_unique_t sorted_unique{};
+
+    namespace detail {
+        // Бинарный поиск без ветвлений: на каждом шаге сдвиг базы выбирается условной пересылкой,
+        // поэтому нет промахов предсказателя, а число итераций зависит только от n
+        template <typename T, typename K, typename Compare>
+        std::size_t branchless_lower_bound(const T* first, std::size_t n, const K& key, const Compare& comp) {
+            if (n == 0) {
+                return 0;
+            }
+
+            const T* base = first;
+            while (n > 1) {
+                const std::size_t half = n / 2;
+                base = comp(base[half], key) ? base + half : base;
+                n -= half;
+            }
+
+            return static_cast<std::size_t>(base - first) + static_cast<std::size_t>(comp(*base, key));
+        }
+    }
+
+    // Отсортированный ассоциативный массив на двух np::vector: ключи отдельно от значений, так что
+    // поиск проходит по плотному массиву ключей. Интерфейс как у Map (find, count, at, operator[]).
+    // Вставка в середину - O(n); рассчитан на "построили один раз - много читаем".
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class flat_map {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using key_compare = Compare;
+        using reference = std::pair<const Key&, Value&>;
+        using const_reference = std::pair<const Key&, const Value&>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using key_container_type = vector<Key>;
+        using mapped_container_type = vector<Value>;
+
+    private:
+        template <bool is_const>
+        class base_iterator {
+            using owner_type = std::conditional_t<is_const, const flat_map, flat_map>;
+
+        public:
+            using reference_type = std::conditional_t<is_const, const_reference, reference>;
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::pair<Key, Value>;
+            using iterator_category = std::input_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+
+            // it->second для итератора, разыменование которого даёт временную пару ссылок
+            struct arrow_proxy {
+                reference_type ref;
+
+                const reference_type* operator->() const noexcept {
+                    return &ref;
+                }
+            };
+
+            owner_type* owner_ = nullptr;
+            size_type index_ = 0;
+
+            /***************************/
+            base_iterator() noexcept = default;
+
+            base_iterator(owner_type* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+
+            // iterator -> const_iterator
+            template <bool other_const> requires (is_const && !other_const)
+            base_iterator(const base_iterator<other_const>& other) noexcept : owner_(other.owner_), index_(other.index_) {}
+            /***************************/
+
+
+            /***************************/
+            reference_type operator*() const {
+                return reference_type(owner_->keys_[index_], owner_->values_[index_]);
+            }
+
+            arrow_proxy operator->() const {
+                return arrow_proxy{**this};
+            }
+
+            reference_type operator[](const difference_type offset) const {
+                return *(*this + offset);
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+
+            base_iterator& operator--() {
+                --index_;
+                return *this;
+            }
+
+            base_iterator operator++(int) {
+                base_iterator temp = *this;
+                ++index_;
+                return temp;
+            }
+
+            base_iterator operator--(int) {
+                base_iterator temp = *this;
+                --index_;
+                return temp;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator operator+(const difference_type value) const {
+                return base_iterator(owner_, index_ + value);
+            }
+
+            friend base_iterator operator+(const difference_type value, const base_iterator& it) {
+                return it + value;
+            }
+
+            base_iterator operator-(const difference_type value) const {
+                return base_iterator(owner_, index_ - value);
+            }
+
+            difference_type operator-(const base_iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            base_iterator& operator+=(const difference_type value) {
+                index_ += value;
+                return *this;
+            }
+
+            base_iterator& operator-=(const difference_type value) {
+                index_ -= value;
+                return *this;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            bool operator==(const base_iterator& other) const {
+                return index_ == other.index_;
+            }
+
+            auto operator<=>(const base_iterator& other) const {
+                return index_ <=> other.index_;
+            }
+            /***************************/
+        };
+
+    public:
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+    public:
+        flat_map() = default;
+
+        explicit flat_map(const key_compare& comp) : comp_(comp) {}
+
+        // keys должны быть отсортированы и без повторов, values - той же длины
+        flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values, const key_compare& comp = key_compare())
+            : keys_(std::move(keys)), values_(std::move(values)), comp_(comp) {
+            if (keys_.size() != values_.size()) {
+                throw std::invalid_argument("flat_map: keys and values differ in length");
+            }
+        }
+
+        flat_map(const std::initializer_list<value_type> list, const key_compare& comp = key_compare()) : comp_(comp) {
+            insert(list.begin(), list.end());
+        }
+
+        template <std::input_iterator InputIt>
+        flat_map(InputIt first, InputIt last, const key_compare& comp = key_compare()) : comp_(comp) {
+            insert(first, last);
+        }
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(this, size()); }
+        const_iterator end() const noexcept { return const_iterator(this, size()); }
+        const_iterator cend() const noexcept { return end(); }
+
+        [[nodiscard]] size_type size() const noexcept { return keys_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+
+        void reserve(const size_type new_capacity) {
+            keys_.reserve(new_capacity);
+            values_.reserve(new_capacity);
+        }
+
+        void clear() noexcept {
+            keys_.clear();
+            values_.clear();
+        }
+
+        // Плотные массивы ключей и значений для последовательных проходов
+        std::span<const Key> keys() const noexcept { return {std::to_address(keys_.data()), keys_.size()}; }
+        std::span<Value> values() noexcept { return {std::to_address(values_.data()), values_.size()}; }
+        std::span<const Value> values() const noexcept { return {std::to_address(values_.data()), values_.size()}; }
+
+        std::pair<iterator, bool> insert(const value_type& value) {
+            return try_emplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value) {
+            return try_emplace(std::move(value.first), std::move(value.second));
+        }
+
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+            const size_type index = lower_bound_index_(key);
+            if (index < size() && !comp_(key, keys_[index])) {
+                return {iterator(this, index), false};
+            }
+
+            keys_.insert(keys_.cbegin() + index, Key(std::forward<K>(key)));
+            try {
+                values_.insert(values_.cbegin() + index, Value(std::forward<Args>(args)...));
+            } catch (...) {
+                keys_.erase(keys_.cbegin() + index);
+                throw;
+            }
+
+            return {iterator(this, index), true};
+        }
+
+        // Произвольный диапазон: сортируется отдельно и сливается с содержимым за один проход.
+        // Из равных ключей остаётся первый, уже имеющиеся ключи не перезаписываются.
+        template <std::input_iterator InputIt>
+        void insert(InputIt first, InputIt last) {
+            vector<value_type> items(first, last);
+            std::stable_sort(items.begin(), items.end(), [this](const value_type& lhs, const value_type& rhs) {
+                return comp_(lhs.first, rhs.first);
+            });
+
+            const auto tail = std::unique(items.begin(), items.end(), [this](const value_type& lhs, const value_type& rhs) {
+                return !comp_(lhs.first, rhs.first) && !comp_(rhs.first, lhs.first);
+            });
+            items.erase(tail, items.end());
+
+            insert(sorted_unique, std::ranges::subrange(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end())));
+        }
+
+        // Диапазон пар, отсортированный по ключу и без повторов: дописывается в конец, если все
+        // ключи больше имеющихся, иначе сливается с содержимым за O(size() + n)
+        template <std::ranges::input_range R>
+        void insert(sorted_unique_t, R&& range) {
+            if constexpr (std::ranges::forward_range<R>) {
+                if (std::ranges::empty(range)) {
+                    return;
+                }
+
+                if (empty() || comp_(keys_.back(), std::get<0>(*std::ranges::begin(range)))) {
+                    append_(std::forward<R>(range));
+                    return;
+                }
+            }
+
+            merge_(std::forward<R>(range));
+        }
+
+        iterator find(const Key& key) {
+            const size_type index = find_index_(key);
+            return iterator(this, index);
+        }
+
+        const_iterator find(const Key& key) const {
+            const size_type index = find_index_(key);
+            return const_iterator(this, index);
+        }
+
+        [[nodiscard]] size_type count(const Key& key) const {
+            return find_index_(key) != size() ? 1 : 0;
+        }
+
+        [[nodiscard]] bool contains(const Key& key) const {
+            return find_index_(key) != size();
+        }
+
+        iterator lower_bound(const Key& key) {
+            return iterator(this, lower_bound_index_(key));
+        }
+
+        const_iterator lower_bound(const Key& key) const {
+            return const_iterator(this, lower_bound_index_(key));
+        }
+
+        Value& at(const Key& key) {
+            const size_type index = find_index_(key);
+            if (index == size()) {
+                throw std::out_of_range("Key not found");
+            }
+
+            return values_[index];
+        }
+
+        [[nodiscard]] const Value& at(const Key& key) const {
+            const size_type index = find_index_(key);
+            if (index == size()) {
+                throw std::out_of_range("Key not found");
+            }
+
+            return values_[index];
+        }
+
+        Value& operator[](const Key& key) {
+            return values_[try_emplace(key).first.index_];
+        }
+
+        iterator erase(const_iterator pos) {
+            keys_.erase(keys_.cbegin() + pos.index_);
+            values_.erase(values_.cbegin() + pos.index_);
+            return iterator(this, pos.index_);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            keys_.erase(keys_.cbegin() + first.index_, keys_.cbegin() + last.index_);
+            values_.erase(values_.cbegin() + first.index_, values_.cbegin() + last.index_);
+            return iterator(this, first.index_);
+        }
+
+        size_type erase(const Key& key) {
+            const size_type index = find_index_(key);
+            if (index == size()) {
+                return 0;
+            }
+
+            erase(const_iterator(this, index));
+            return 1;
+        }
+
+        void swap(flat_map& other) noexcept {
+            keys_.swap(other.keys_);
+            values_.swap(other.values_);
+            std::swap(comp_, other.comp_);
+        }
+
+    private:
+        size_type lower_bound_index_(const Key& key) const {
+            return detail::branchless_lower_bound(std::to_address(keys_.data()), keys_.size(), key, comp_);
+        }
+
+        size_type find_index_(const Key& key) const {
+            const size_type index = lower_bound_index_(key);
+            return index < size() && !comp_(key, keys_[index]) ? index : size();
+        }
+
+        template <typename R>
+        void append_(R&& range) {
+            const size_type old_size = size();
+            try {
+                for (auto&& item : range) {
+                    keys_.push_back(std::get<0>(std::forward<decltype(item)>(item)));
+                    values_.push_back(std::get<1>(std::forward<decltype(item)>(item)));
+                }
+            } catch (...) {
+                keys_.erase(keys_.cbegin() + old_size, keys_.cend());
+                values_.erase(values_.cbegin() + std::min(old_size, values_.size()), values_.cend());
+                throw;
+            }
+        }
+
+        // Слияние в новые массивы: при исключении текущее содержимое не меняется
+        template <typename R>
+        void merge_(R&& range) {
+            key_container_type keys;
+            mapped_container_type values;
+
+            size_type extra = 0;
+            if constexpr (std::ranges::sized_range<R>) {
+                extra = static_cast<size_type>(std::ranges::size(range));
+            }
+            keys.reserve(size() + extra);
+            values.reserve(size() + extra);
+
+            size_type index = 0;
+            for (auto&& item : range) {
+                const auto& key = std::get<0>(item);
+                for (; index < size() && comp_(keys_[index], key); ++index) {
+                    keys.push_back(keys_[index]);
+                    values.push_back(values_[index]);
+                }
+
+                if (index < size() && !comp_(key, keys_[index])) {
+                    continue;
+                }
+
+                keys.push_back(std::get<0>(std::forward<decltype(item)>(item)));
+                values.push_back(std::get<1>(std::forward<decltype(item)>(item)));
+            }
+
+            for (; index < size(); ++index) {
+                keys.push_back(keys_[index]);
+                values.push_back(values_[index]);
+            }
+
+            keys_.swap(keys);
+            values_.swap(values);
+        }
+
+        key_container_type keys_;
+        mapped_container_type values_;
+        [[no_unique_address]] key_compare comp_;
+    };
+
+    template <typename Key, typename Value, typename Compare>
+    void swap(flat_map<Key, Value, Compare>& lhs, flat_map<Key, Value, Compare>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+#include "flat_map.hpp"
+
+namespace np {
+    // Отсортированное множество на одном np::vector с тем же поиском без ветвлений, что у flat_map
+    template <typename Key, typename Compare = std::less<Key>>
+    class flat_set {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using container_type = vector<Key>;
+
+        // Ключи менять нельзя: оба итератора константные
+        using iterator = typename container_type::const_iterator;
+        using const_iterator = typename container_type::const_iterator;
+
+        flat_set() = default;
+
+        explicit flat_set(const key_compare& comp) : comp_(comp) {}
+
+        flat_set(sorted_unique_t, container_type keys, const key_compare& comp = key_compare()) : keys_(std::move(keys)), comp_(comp) {}
+
+        flat_set(const std::initializer_list<Key> list, const key_compare& comp = key_compare()) : comp_(comp) {
+            insert(list.begin(), list.end());
+        }
+
+        template <std::input_iterator InputIt>
+        flat_set(InputIt first, InputIt last, const key_compare& comp = key_compare()) : comp_(comp) {
+            insert(first, last);
+        }
+
+        const_iterator begin() const noexcept { return keys_.begin(); }
+        const_iterator cbegin() const noexcept { return keys_.cbegin(); }
+
+        const_iterator end() const noexcept { return keys_.end(); }
+        const_iterator cend() const noexcept { return keys_.cend(); }
+
+        [[nodiscard]] size_type size() const noexcept { return keys_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+
+        void reserve(const size_type new_capacity) { keys_.reserve(new_capacity); }
+        void clear() noexcept { keys_.clear(); }
+
+        std::pair<iterator, bool> insert(const Key& key) {
+            return emplace_(key);
+        }
+
+        std::pair<iterator, bool> insert(Key&& key) {
+            return emplace_(std::move(key));
+        }
+
+        template <std::input_iterator InputIt>
+        void insert(InputIt first, InputIt last) {
+            container_type items(first, last);
+            std::stable_sort(items.begin(), items.end(), comp_);
+            items.erase(std::unique(items.begin(), items.end(), [this](const Key& lhs, const Key& rhs) {
+                return !comp_(lhs, rhs) && !comp_(rhs, lhs);
+            }), items.end());
+
+            insert(sorted_unique, std::ranges::subrange(std::make_move_iterator(items.begin()), std::make_move_iterator(items.end())));
+        }
+
+        template <std::ranges::input_range R>
+        void insert(sorted_unique_t, R&& range) {
+            if constexpr (std::ranges::forward_range<R>) {
+                if (std::ranges::empty(range)) {
+                    return;
+                }
+
+                if (empty() || comp_(keys_.back(), *std::ranges::begin(range))) {
+                    keys_.append_range(std::forward<R>(range));
+                    return;
+                }
+            }
+
+            container_type keys;
+            if constexpr (std::ranges::sized_range<R>) {
+                keys.reserve(size() + static_cast<size_type>(std::ranges::size(range)));
+            }
+
+            size_type index = 0;
+            for (auto&& key : range) {
+                for (; index < size() && comp_(keys_[index], key); ++index) {
+                    keys.push_back(keys_[index]);
+                }
+
+                if (index < size() && !comp_(key, keys_[index])) {
+                    continue;
+                }
+
+                keys.push_back(std::forward<decltype(key)>(key));
+            }
+
+            for (; index < size(); ++index) {
+                keys.push_back(keys_[index]);
+            }
+
+            keys_.swap(keys);
+        }
+
+        const_iterator find(const Key& key) const {
+            return keys_.cbegin() + find_index_(key);
+        }
+
+        [[nodiscard]] size_type count(const Key& key) const {
+            return find_index_(key) != size() ? 1 : 0;
+        }
+
+        [[nodiscard]] bool contains(const Key& key) const {
+            return find_index_(key) != size();
+        }
+
+        const_iterator lower_bound(const Key& key) const {
+            return keys_.cbegin() + lower_bound_index_(key);
+        }
+
+        iterator erase(const_iterator pos) {
+            return keys_.erase(pos);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            return keys_.erase(first, last);
+        }
+
+        size_type erase(const Key& key) {
+            const size_type index = find_index_(key);
+            if (index == size()) {
+                return 0;
+            }
+
+            keys_.erase(keys_.cbegin() + index);
+            return 1;
+        }
+
+        void swap(flat_set& other) noexcept {
+            keys_.swap(other.keys_);
+            std::swap(comp_, other.comp_);
+        }
+
+    private:
+        size_type lower_bound_index_(const Key& key) const {
+            return detail::branchless_lower_bound(std::to_address(keys_.data()), keys_.size(), key, comp_);
+        }
+
+        size_type find_index_(const Key& key) const {
+            const size_type index = lower_bound_index_(key);
+            return index < size() && !comp_(key, keys_[index]) ? index : size();
+        }
+
+        template <typename K>
+        std::pair<iterator, bool> emplace_(K&& key) {
+            const size_type index = lower_bound_index_(key);
+            if (index < size() && !comp_(key, keys_[index])) {
+                return {keys_.cbegin() + index, false};
+            }
+
+            keys_.insert(keys_.cbegin() + index, std::forward<K>(key));
+            return {keys_.cbegin() + index, true};
+        }
+
+        container_type keys_;
+        [[no_unique_address]] key_compare comp_;
+    };
+
+    template <typename Key, typename Compare>
+    void swap(flat_set<Key, Compare>& lhs, flat_set<Key, Compare>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,440 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../vector/container_stats.hpp"
+
+template <typename Key, typename Value, typename Compare = std::less<Key>, typename Stats = np::no_stats>
+class Map {
+    using value_type = std::pair<const Key, Value>;
+
+    template<class Iter, class NodeType>
+    struct Insert_return_type
+    {
+            Iter     position;
+            bool     inserted;
+            NodeType node;
+    };
+
+    struct Base_node {
+        Base_node* parent   = nullptr;
+        Base_node* left     = nullptr;
+        Base_node* right    = nullptr;
+        bool red  = false;
+
+        Base_node() = default;
+
+        Base_node(const Base_node&) = delete;
+        Base_node(Base_node&) = delete;
+
+        Base_node& operator=(Base_node&) = delete;
+        Base_node& operator=(const Base_node&) = delete;
+
+        virtual ~Base_node() = default;
+    };
+
+    struct Node final : public Base_node {
+        value_type kv;
+
+        explicit Node(const value_type& data) : kv(data) {}
+
+        Node() = delete;
+
+        Node(const Node&) = delete;
+        Node(Node&) = delete;
+
+        Node& operator=(Node&) = delete;
+        Node& operator=(const Node&) = delete;
+
+        ~Node()override = default;
+    };
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using key_compare = Compare;
+
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+
+    using mapped_type = Value;
+    using node_type = Node;
+
+    Base_node* root_ = nullptr;
+    size_type size_ = 0;
+
+    [[no_unique_address]] Stats stats_;
+
+    Node* create_node_(const value_type& value) {
+        Node* node = new Node(value);
+        stats_.on_allocate(sizeof(Node));
+        stats_.on_copy(1);
+        ++size_;
+        return node;
+    }
+
+    template<const bool is_const>
+    class Base_iterator {
+    public:
+        Base_node* current = nullptr;
+
+        using iterator_category =   std::bidirectional_iterator_tag;
+        using value_type        =   std::conditional_t<is_const, std::pair<const Key, const Value>, std::pair<const Key, Value>>;
+        using difference_type   =   std::ptrdiff_t;
+        using pointer           =   value_type*;
+        using reference         =   value_type&;
+
+        Base_iterator() = default;
+        Base_iterator(Base_node* node) : current(node) {}
+        Base_iterator(const Base_iterator& base) {
+            current = base.current;
+        }
+
+        [[nodiscard]] Base_node* get_base_node() {
+            return current;
+        }
+
+        reference operator*() const {
+            return static_cast<Node*>(current)->kv;
+        }
+
+        pointer operator->() const {
+            return &(static_cast<Node*>(current)->kv);
+        }
+
+        bool operator==(const Base_iterator& other) const {
+            return current == other.current;
+        }
+
+        bool operator!=(const Base_iterator& other) const {
+            return current != other.current;
+        }
+
+        bool operator<(const Base_iterator& other) const {
+            return current < other.current;
+        }
+
+        bool operator>(const Base_iterator& other) const {
+            return current > other.current;
+        }
+
+        bool operator<=(const Base_iterator& other) const {
+            return current <= other.current;
+        }
+
+        bool operator>=(const Base_iterator& other) const {
+            return current >= other.current;
+        }
+
+        auto operator<=>(const Base_iterator& other) const = default;
+
+        operator Base_iterator<true>() const {
+            return Base_iterator<true>(current);
+        }
+    };
+
+public:
+    Map() = default;
+
+    Map(const Map&) = delete;
+    Map& operator=(const Map&) = delete;
+
+    // Узлы обходятся явным стеком: дерево не балансируется и может быть глубиной в size()
+    ~Map() {
+        if (root_ == nullptr) {
+            return;
+        }
+
+        std::vector<Base_node*> pending{root_->parent};
+        while (!pending.empty()) {
+            Base_node* node = pending.back();
+            pending.pop_back();
+
+            if (node == nullptr) {
+                continue;
+            }
+
+            pending.push_back(node->left);
+            pending.push_back(node->right);
+
+            delete node;
+            stats_.on_deallocate(sizeof(Node));
+        }
+
+        delete root_;
+        stats_.on_deallocate(sizeof(Base_node));
+    }
+
+    using iterator = Base_iterator<false>;
+    using const_iterator = Base_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    iterator begin() noexcept {
+        return iterator(root_->left);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(root_->left);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    iterator end() noexcept {
+        return iterator(root_->right);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(root_->right);
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Счётчики политики Stats; с np::no_stats - нулевой снимок
+    [[nodiscard]] np::stats_snapshot stats() const noexcept {
+        np::stats_snapshot snapshot = stats_.snapshot();
+        if constexpr (Stats::enabled) {
+            snapshot.bytes_used = size_ * sizeof(value_type);
+        }
+
+        return snapshot;
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        if(root_ == nullptr) {
+            root_ = new Base_node;
+            stats_.on_allocate(sizeof(Base_node));
+        }
+
+        // После erase заголовок остаётся и без узлов
+        if(root_->parent == nullptr) {
+            root_->parent = create_node_(value);
+
+            return std::make_pair(iterator(root_->parent), true);
+        }
+
+        Node* node = static_cast<Node*>(root_->parent);
+
+        while(node != nullptr) {
+            if(node->kv.first < value.first) {
+                if(node->left != nullptr) {
+                    node = static_cast<Node*>(node->left);
+                } else {
+                    root_->left = node->left = create_node_(value);
+                    node->left->parent = node;
+                    return {iterator(node->left), true};
+                }
+            } else if(node->kv.first > value.first) {
+                if(node->right != nullptr) {
+                    node = static_cast<Node*>(node->right);
+                } else {
+                    root_->right = node->right = create_node_(value);
+                    node->right->parent = node;
+                    return {iterator(node->right), true};
+                }
+            } else {
+                return {iterator(node), false};
+            }
+        }
+
+        return {iterator(nullptr), false};
+    }
+    [[nodiscard]] iterator find( const Key& key ) const {
+        if(root_ == nullptr) {
+            return iterator(nullptr);
+        }
+
+        Node* node = static_cast<Node*>(root_->parent);
+
+        while(node != nullptr) {
+            if(node->kv.first < key) {
+                node = static_cast<Node*>(node->left);
+            }
+            else if(node->kv.first > key) {
+                node = static_cast<Node*>(node->right);
+            } else {
+                return iterator(node);
+            }
+        }
+
+        return iterator(nullptr);
+    }
+
+    Value& operator[](const Key& key) {
+        std::pair<iterator, bool> it = insert({key, Value()});
+
+        return it.first->second;
+    }
+
+    [[nodiscard]] size_type count( const Key& key ) const {
+        if(find(key).current == nullptr) {
+            return 0;
+        }
+
+        return 1;
+    }
+
+    [[nodiscard]] const Value& at( const Key& key ) const {
+        if (count(key)) {
+            return find(key)->second; // Возвращаем значение по найденному ключу
+        }
+
+        throw std::out_of_range("Key not found"); // Исключение, если ключ не найден
+    }
+
+    // Узел без двух детей заменяется своим ребёнком, узел с двумя - соседним по ключу из правого
+    // поддерева. Узлы перевешиваются, а не копируются: итераторы на остальные элементы остаются
+    // валидными. Возвращает итератор на следующий по возрастанию ключ, как find - nullptr, если
+    // такого нет
+    iterator erase( iterator pos ) {
+        Base_node* node = pos.current;
+        if(root_ == nullptr || node == nullptr) {
+            return iterator(nullptr);
+        }
+
+        Base_node* next = next_node_(node);
+
+        if(node->left == nullptr) {
+            transplant_(node, node->right);
+        } else if(node->right == nullptr) {
+            transplant_(node, node->left);
+        } else {
+            Base_node* heir = node->right;
+            while(heir->left != nullptr) {
+                heir = heir->left;
+            }
+
+            if(heir->parent != node) {
+                transplant_(heir, heir->right);
+                heir->right = node->right;
+                heir->right->parent = heir;
+            }
+
+            transplant_(node, heir);
+            heir->left = node->left;
+            heir->left->parent = heir;
+        }
+
+        // Заголовок не должен смотреть на удалённый узел
+        if(root_->left == node) {
+            root_->left = nullptr;
+        }
+        if(root_->right == node) {
+            root_->right = nullptr;
+        }
+
+        delete static_cast<Node*>(node);
+        stats_.on_deallocate(sizeof(Node));
+        --size_;
+
+        return iterator(next);
+    }
+
+    iterator erase( const_iterator pos ) {
+        return erase(iterator(pos.current));
+    }
+
+    iterator erase( iterator first, iterator last ) {
+        Base_node* node = first.current;
+        while(node != last.current && node != nullptr) {
+            node = erase(iterator(node)).current;
+        }
+
+        return last;
+    }
+
+    iterator erase( const_iterator first, const_iterator last ) {
+        return erase(iterator(first.current), iterator(last.current));
+    }
+
+    size_type erase( const Key& key ) {
+        iterator it = find(key);
+        if(it.current == nullptr) {
+            return 0;
+        }
+
+        erase(it);
+        return 1;
+    }
+
+private:
+    // Ставит поддерево replacement на место поддерева node
+    void transplant_(Base_node* node, Base_node* replacement) noexcept {
+        if(node->parent == nullptr) {
+            root_->parent = replacement;
+        } else if(node->parent->left == node) {
+            node->parent->left = replacement;
+        } else {
+            node->parent->right = replacement;
+        }
+
+        if(replacement != nullptr) {
+            replacement->parent = node->parent;
+        }
+    }
+
+    // Следующий по возрастанию ключ. Большие ключи лежат слева (см. insert)
+    static Base_node* next_node_(Base_node* node) noexcept {
+        if(node->left != nullptr) {
+            node = node->left;
+            while(node->right != nullptr) {
+                node = node->right;
+            }
+
+            return node;
+        }
+
+        Base_node* parent = node->parent;
+        while(parent != nullptr && parent->left == node) {
+            node = parent;
+            parent = parent->parent;
+        }
+
+        return parent;
+    }
+
+};
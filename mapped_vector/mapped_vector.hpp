@@ -0,0 +1,317 @@
+#pragma once
+
+#if !defined(__unix__) && !defined(__APPLE__)
+    #error "np::mapped_vector requires POSIX mmap"
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/binary_header.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace np {
+    enum class open_mode {
+        read_only,      // файл должен существовать, запись запрещена
+        read_write,     // файл должен существовать
+        create,         // новый пустой файл (существующий перезаписывается)
+        open_or_create
+    };
+
+    // Вектор тривиально копируемых T, лежащий прямо в отображённом файле. Открытие - это open + mmap,
+    // без разбора и копирования: элементы читаются из страничного кэша по мере обращения.
+    // Рост расширяет файл (ftruncate) и отображение (mremap на Linux), flush() сбрасывает на диск через msync.
+    template <typename T>
+    class mapped_vector {
+        static_assert(std::is_trivially_copyable_v<T>, "mapped_vector stores raw bytes of T");
+        static_assert(alignof(T) <= sizeof(detail::binary_header), "elements start right after the 64-byte header");
+
+    public:
+        using value_type = T;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        mapped_vector() noexcept = default;
+
+        explicit mapped_vector(const std::string& path, const open_mode mode = open_mode::open_or_create) : mode_(mode) {
+            const bool writable = mode != open_mode::read_only;
+            int flags = writable ? O_RDWR : O_RDONLY;
+            if (mode == open_mode::create) {
+                flags |= O_CREAT | O_TRUNC;
+            }
+            else if (mode == open_mode::open_or_create) {
+                flags |= O_CREAT;
+            }
+
+            fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+            if (fd_ < 0) {
+                throw std::system_error(errno, std::generic_category(), "mapped_vector: open " + path);
+            }
+
+            try {
+                struct stat info {};
+                if (::fstat(fd_, &info) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "mapped_vector: fstat");
+                }
+
+                if (info.st_size == 0 && writable) {
+                    resize_file_(bytes_for_(0));
+                    map_(bytes_for_(0));
+                    init_header_();
+                }
+                else {
+                    map_(static_cast<std::size_t>(info.st_size));
+                    validate_header_();
+                }
+            } catch (...) {
+                close();
+                throw;
+            }
+        }
+
+        mapped_vector(const mapped_vector&) = delete;
+        mapped_vector& operator=(const mapped_vector&) = delete;
+
+        mapped_vector(mapped_vector&& other) noexcept
+            : fd_(std::exchange(other.fd_, -1)), mode_(other.mode_),
+              mapping_(std::exchange(other.mapping_, nullptr)), mapping_size_(std::exchange(other.mapping_size_, 0)) {}
+
+        mapped_vector& operator=(mapped_vector&& other) noexcept {
+            if (this != &other) {
+                close();
+                fd_ = std::exchange(other.fd_, -1);
+                mode_ = other.mode_;
+                mapping_ = std::exchange(other.mapping_, nullptr);
+                mapping_size_ = std::exchange(other.mapping_size_, 0);
+            }
+
+            return *this;
+        }
+
+        ~mapped_vector() {
+            close();
+        }
+
+        // Отображение снимается без msync: ядро допишет страницы само, но без гарантий при сбое
+        void close() noexcept {
+            if (mapping_ != nullptr) {
+                ::munmap(mapping_, mapping_size_);
+                mapping_ = nullptr;
+                mapping_size_ = 0;
+            }
+
+            if (fd_ >= 0) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        [[nodiscard]] bool is_open() const noexcept { return mapping_ != nullptr; }
+
+        // Синхронный сброс изменённых страниц (и заголовка) на диск
+        void flush() {
+            if (mapping_ != nullptr && ::msync(mapping_, mapping_size_, MS_SYNC) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mapped_vector: msync");
+            }
+        }
+
+        void flush_async() noexcept {
+            if (mapping_ != nullptr) {
+                ::msync(mapping_, mapping_size_, MS_ASYNC);
+            }
+        }
+
+        void reserve(const size_type new_capacity) {
+            if (new_capacity > capacity()) {
+                remap_(new_capacity);
+            }
+        }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args) {
+            check_writable_();
+            if (size() == capacity()) {
+                // Аргументы могут ссылаться на элемент, а remap_ переносит отображение
+                const value_type temp(std::forward<Args>(args)...);
+                remap_(capacity() ? capacity() * 2 : initial_capacity_());
+                return *::new (static_cast<void*>(data() + header_()->size++)) value_type(temp);
+            }
+
+            return *::new (static_cast<void*>(data() + header_()->size++)) value_type(std::forward<Args>(args)...);
+        }
+
+        void pop_back() {
+            check_writable_();
+            --header_()->size;
+        }
+
+        void clear() {
+            check_writable_();
+            header_()->size = 0;
+        }
+
+        void resize(const size_type count, const_reference value = value_type()) {
+            check_writable_();
+            if (count > capacity()) {
+                remap_(count);
+            }
+
+            if (count > size()) {
+                std::fill(data() + size(), data() + count, value);
+            }
+
+            header_()->size = count;
+        }
+
+        // Обрезает файл до занятых элементов
+        void shrink_to_fit() {
+            if (size() < capacity()) {
+                remap_(size());
+            }
+        }
+
+        [[nodiscard]] size_type size() const noexcept { return mapping_ ? static_cast<size_type>(header_()->size) : 0; }
+        [[nodiscard]] size_type capacity() const noexcept { return mapping_ ? static_cast<size_type>(header_()->capacity) : 0; }
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        pointer data() noexcept { return mapping_ ? reinterpret_cast<pointer>(static_cast<char*>(mapping_) + sizeof(detail::binary_header)) : nullptr; }
+        const_pointer data() const noexcept { return mapping_ ? reinterpret_cast<const_pointer>(static_cast<const char*>(mapping_) + sizeof(detail::binary_header)) : nullptr; }
+
+        iterator begin() noexcept { return data(); }
+        const_iterator begin() const noexcept { return data(); }
+        const_iterator cbegin() const noexcept { return data(); }
+
+        iterator end() noexcept { return data() + size(); }
+        const_iterator end() const noexcept { return data() + size(); }
+        const_iterator cend() const noexcept { return data() + size(); }
+
+        reference front() { return data()[0]; }
+        const_reference front() const { return data()[0]; }
+
+        reference back() { return data()[size() - 1]; }
+        const_reference back() const { return data()[size() - 1]; }
+
+        reference operator[](const size_type index) { return data()[index]; }
+        const_reference operator[](const size_type index) const { return data()[index]; }
+
+        reference at(const size_type index) {
+            if (index >= size()) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return data()[index];
+        }
+
+        const_reference at(const size_type index) const {
+            if (index >= size()) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return data()[index];
+        }
+
+    private:
+        static constexpr std::size_t bytes_for_(const size_type capacity) noexcept {
+            return sizeof(detail::binary_header) + capacity * sizeof(value_type);
+        }
+
+        // Первое расширение сразу добирает файл до целой страницы
+        static size_type initial_capacity_() noexcept {
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return std::max<size_type>(1, (page - sizeof(detail::binary_header)) / sizeof(value_type));
+        }
+
+        detail::binary_header* header_() noexcept { return static_cast<detail::binary_header*>(mapping_); }
+        const detail::binary_header* header_() const noexcept { return static_cast<const detail::binary_header*>(mapping_); }
+
+        void resize_file_(const std::size_t bytes) {
+            if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mapped_vector: ftruncate");
+            }
+        }
+
+        void map_(const std::size_t bytes) {
+            const int protection = mode_ == open_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+            void* ptr = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+            if (ptr == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mapped_vector: mmap");
+            }
+
+            mapping_ = ptr;
+            mapping_size_ = bytes;
+        }
+
+        void check_writable_() const {
+            if (mode_ == open_mode::read_only) {
+                throw std::logic_error("mapped_vector: opened read-only");
+            }
+        }
+
+        void remap_(const size_type new_capacity) {
+            check_writable_();
+
+            const std::size_t new_bytes = bytes_for_(new_capacity);
+            if (new_bytes > mapping_size_) {
+                resize_file_(new_bytes);
+            }
+
+#if defined(__linux__)
+            void* ptr = ::mremap(mapping_, mapping_size_, new_bytes, MREMAP_MAYMOVE);
+            if (ptr == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mapped_vector: mremap");
+            }
+
+            mapping_ = ptr;
+            mapping_size_ = new_bytes;
+#else
+            ::munmap(mapping_, mapping_size_);
+            mapping_ = nullptr;
+            map_(new_bytes);
+#endif
+
+            if (new_bytes < bytes_for_(capacity())) {
+                resize_file_(new_bytes);
+            }
+
+            header_()->capacity = new_capacity;
+        }
+
+        void init_header_() noexcept {
+            *header_() = detail::make_binary_header<value_type>(0, 0);
+        }
+
+        void validate_header_() const {
+            if (mapping_size_ < sizeof(detail::binary_header)) {
+                throw std::runtime_error("mapped_vector: file is too small");
+            }
+
+            detail::validate_binary_header<value_type>(*header_(), mapping_size_ - sizeof(detail::binary_header), "mapped_vector");
+        }
+
+        int fd_ = -1;
+        open_mode mode_ = open_mode::read_only;
+
+        void* mapping_ = nullptr;
+        std::size_t mapping_size_ = 0;
+    };
+}
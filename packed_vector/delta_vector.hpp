@@ -0,0 +1,379 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "packed_vector.hpp"
+
+namespace np {
+    // Вектор целых в блочной frame-of-reference кодировке для данных, которые в основном читают:
+    // идентификаторы, отметки времени, отсортированные списки. Каждые 128 значений хранятся как
+    // минимум блока и разности с ним, упакованные в ширину самой большой разности. Монотонный ряд
+    // с малым шагом занимает несколько бит на значение независимо от величины самих чисел.
+    //
+    // Блок из 128 полей шириной w занимает ровно 2w слов, так что доступ по индексу - заголовок
+    // блока и одно извлечение поля. Последние неполные 128 значений лежат несжатыми, блок
+    // упаковывается, когда заполняется. Последовательный проход (for_each, decode) распаковывает
+    // блоки целиком SIMD-ядром. Слово-заполнитель в data_ появляется вместе с первым блоком,
+    // поэтому пустой вектор, в том числе перемещённый, не держит памяти.
+    template <typename Allocator = std::allocator<std::uint64_t>>
+    class delta_vector {
+        using word_type = std::uint64_t;
+
+    public:
+        using value_type = std::uint64_t;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using const_reference = value_type;
+
+        static constexpr size_type block_size = 128;
+
+    private:
+        // Минимум блока и смещение его полей в data_ (в словах) вместе с шириной в младших 8 битах
+        struct block_header {
+            std::uint64_t base;
+            std::uint64_t offset_width;
+        };
+
+        using header_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<block_header>;
+
+        class base_iterator {
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::uint64_t;
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+
+            const delta_vector* owner_ = nullptr;
+            size_type index_ = 0;
+
+            /***************************/
+            base_iterator() noexcept = default;
+
+            base_iterator(const delta_vector* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+            /***************************/
+
+
+            /***************************/
+            value_type operator*() const {
+                return (*owner_)[index_];
+            }
+
+            value_type operator[](const difference_type index) const {
+                return (*owner_)[index_ + index];
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator& operator++() noexcept {
+                ++index_;
+                return *this;
+            }
+
+            base_iterator& operator--() noexcept {
+                --index_;
+                return *this;
+            }
+
+            base_iterator operator++(int) noexcept {
+                base_iterator temp = *this;
+                ++index_;
+                return temp;
+            }
+
+            base_iterator operator--(int) noexcept {
+                base_iterator temp = *this;
+                --index_;
+                return temp;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator operator+(const difference_type value) const noexcept {
+                return base_iterator(owner_, index_ + value);
+            }
+
+            friend base_iterator operator+(const difference_type value, const base_iterator& it) noexcept {
+                return it + value;
+            }
+
+            base_iterator operator-(const difference_type value) const noexcept {
+                return base_iterator(owner_, index_ - value);
+            }
+
+            difference_type operator-(const base_iterator& other) const noexcept {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            base_iterator& operator+=(const difference_type value) noexcept {
+                index_ += value;
+                return *this;
+            }
+
+            base_iterator& operator-=(const difference_type value) noexcept {
+                index_ -= value;
+                return *this;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            bool operator==(const base_iterator& other) const noexcept {
+                return index_ == other.index_;
+            }
+
+            auto operator<=>(const base_iterator& other) const noexcept {
+                return index_ <=> other.index_;
+            }
+            /***************************/
+        };
+
+    public:
+        // Значения только читаются через итераторы, изменение - push_back / pop_back
+        using iterator = base_iterator;
+        using const_iterator = base_iterator;
+
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = reverse_iterator;
+
+    public:
+        delta_vector() noexcept(noexcept(allocator_type())) : delta_vector(allocator_type()) {}
+
+        explicit delta_vector(const allocator_type& alloc) noexcept : headers_(header_allocator(alloc)), data_(alloc), tail_(alloc) {}
+
+        delta_vector(const std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+            : delta_vector(list.begin(), list.end(), alloc) {}
+
+        template <std::input_iterator InputIt>
+        delta_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : delta_vector(alloc) {
+            for (; first != last; ++first) {
+                push_back(static_cast<value_type>(*first));
+            }
+            shrink_to_fit();
+        }
+
+        delta_vector(const delta_vector&) = default;
+        delta_vector& operator=(const delta_vector&) = default;
+
+        // Перемещённый вектор остаётся пустым и без слов
+        delta_vector(delta_vector&& other) noexcept
+            : headers_(std::move(other.headers_)), data_(std::move(other.data_)), tail_(std::move(other.tail_)), size_(std::exchange(other.size_, 0)) {}
+
+        delta_vector& operator=(delta_vector&& other) noexcept(std::is_nothrow_move_assignable_v<vector<word_type, Allocator>>) {
+            if (this != &other) {
+                headers_ = std::move(other.headers_);
+                data_ = std::move(other.data_);
+                tail_ = std::move(other.tail_);
+                size_ = std::exchange(other.size_, 0);
+                // С неравными аллокаторами элементы перемещаются по одному и остаются у источника
+                other.headers_.clear();
+                other.data_.clear();
+                other.tail_.clear();
+            }
+
+            return *this;
+        }
+
+        ~delta_vector() = default;
+
+        void swap(delta_vector& other) noexcept {
+            headers_.swap(other.headers_);
+            data_.swap(other.data_);
+            tail_.swap(other.tail_);
+            std::swap(size_, other.size_);
+        }
+
+        /***************************/
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        const_iterator end() const noexcept { return const_iterator(this, size_); }
+        const_iterator cend() const noexcept { return end(); }
+
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+        /***************************/
+
+        [[nodiscard]] size_type size() const noexcept {
+            return size_;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        // Байты под заголовки, упакованные блоки и несжатый хвост
+        [[nodiscard]] size_type bytes() const noexcept {
+            return headers_.size() * sizeof(block_header) + (data_.size() + tail_.size()) * sizeof(word_type);
+        }
+
+        void reserve_blocks(const size_type blocks) {
+            headers_.reserve(blocks);
+        }
+
+        void shrink_to_fit() {
+            headers_.shrink_to_fit();
+            data_.shrink_to_fit();
+            tail_.shrink_to_fit();
+        }
+
+        void clear() noexcept {
+            headers_.clear();
+            data_.clear();
+            tail_.clear();
+            size_ = 0;
+        }
+
+        void push_back(const value_type value) {
+            tail_.push_back(value);
+            ++size_;
+
+            if (tail_.size() == block_size) {
+                seal_();
+            }
+        }
+
+        // Снятие последнего значения; если хвост пуст, последний блок распаковывается обратно
+        void pop_back() {
+            if (tail_.empty()) {
+                unseal_();
+            }
+
+            tail_.pop_back();
+            --size_;
+        }
+
+        /***************************/
+        const_reference operator[](const size_type index) const noexcept {
+            const size_type block = index / block_size;
+            if (block == headers_.size()) {
+                return tail_[index % block_size];
+            }
+
+            const block_header& header = headers_[block];
+            const unsigned width = static_cast<unsigned>(header.offset_width & 0xFF);
+            return header.base + simd::detail::extract_bits(std::to_address(data_.data()) + (header.offset_width >> 8), index % block_size * width, width);
+        }
+
+        const_reference at(const size_type index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return (*this)[index];
+        }
+
+        const_reference front() const { return (*this)[0]; }
+        const_reference back() const { return (*this)[size_ - 1]; }
+        /***************************/
+
+        // Распаковка count значений начиная с first в out
+        void decode(size_type first, size_type count, value_type* out) const noexcept {
+            while (count > 0) {
+                const size_type block = first / block_size;
+                const size_type offset = first % block_size;
+                const size_type chunk = std::min(count, block_size - offset);
+
+                decode_block_(block, offset, chunk, out);
+
+                first += chunk;
+                count -= chunk;
+                out += chunk;
+            }
+        }
+
+        // Последовательный проход: блоки распаковываются SIMD-ядром в буфер на стеке
+        template <typename Fn>
+        void for_each(Fn fn) const {
+            value_type buffer[block_size];
+
+            for (size_type block = 0; block * block_size < size_; ++block) {
+                const size_type count = std::min(block_size, size_ - block * block_size);
+                decode_block_(block, 0, count, buffer);
+
+                for (size_type i = 0; i < count; ++i) {
+                    fn(buffer[i]);
+                }
+            }
+        }
+
+        friend bool operator==(const delta_vector& lhs, const delta_vector& rhs) {
+            return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+    private:
+        void decode_block_(const size_type block, const size_type first, const size_type count, value_type* out) const noexcept {
+            if (block == headers_.size()) {
+                std::copy_n(tail_.data() + first, count, out);
+                return;
+            }
+
+            const block_header& header = headers_[block];
+            simd::unpack(std::to_address(data_.data()) + (header.offset_width >> 8), first,
+                         static_cast<unsigned>(header.offset_width & 0xFF), header.base, out, count);
+        }
+
+        // Упаковка заполненного хвоста в блок: 128 полей по width бит - ровно 2 * width слов
+        void seal_() {
+            const auto [min, max] = std::minmax_element(tail_.begin(), tail_.end());
+            const value_type base = *min;
+            const unsigned width = static_cast<unsigned>(std::bit_width(*max - base));
+
+            // Первый блок сначала заводит слово-заполнитель
+            if (data_.empty()) {
+                data_.push_back(0);
+            }
+
+            const size_type offset = data_.size() - 1;
+            headers_.push_back({base, (offset << 8) | width});
+            // Блок из одинаковых значений (width == 0) всё же занимает слово: поле читается парой слов.
+            // Слова добавляются по одному, чтобы data_ росла геометрически, а не на блок за раз.
+            for (size_type i = std::max<size_type>(2 * width, 1); i > 0; --i) {
+                data_.push_back(0);
+            }
+
+            word_type* fields = std::to_address(data_.data()) + offset;
+            for (size_type i = 0; i < block_size; ++i) {
+                detail::deposit_bits(fields, i * width, width, tail_[i] - base);
+            }
+
+            tail_.clear();
+        }
+
+        void unseal_() {
+            const size_type block = headers_.size() - 1;
+            const size_type offset = headers_.back().offset_width >> 8;
+
+            tail_.resize(block_size);
+            decode_block_(block, 0, block_size, tail_.data());
+
+            headers_.pop_back();
+            data_.resize(offset + 1);
+            data_.back() = 0;
+        }
+
+        vector<block_header, header_allocator> headers_;
+        vector<word_type, Allocator> data_;
+        vector<word_type, Allocator> tail_;
+        size_type size_ = 0;
+    };
+
+    static_assert(std::random_access_iterator<delta_vector<>::const_iterator>);
+}
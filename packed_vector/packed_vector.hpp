@@ -0,0 +1,429 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/vector.hpp"
+
+namespace np {
+    namespace detail {
+        inline constexpr std::uint64_t low_bits_mask(const unsigned width) noexcept {
+            return width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+        }
+
+        // Запись value (уже обрезанного до width бит) в поле с бита offset
+        inline void deposit_bits(std::uint64_t* words, const std::size_t offset, const unsigned width, const std::uint64_t value) noexcept {
+            const std::size_t word = offset / 64;
+            const unsigned shift = static_cast<unsigned>(offset % 64);
+            const std::uint64_t mask = low_bits_mask(width);
+
+            words[word] = (words[word] & ~(mask << shift)) | (value << shift);
+            if (shift + width > 64) {
+                const unsigned spill = 64 - shift;
+                words[word + 1] = (words[word + 1] & ~(mask >> spill)) | (value >> spill);
+            }
+        }
+    }
+
+    // Вектор целых фиксированной ширины Bits бит, упакованных подряд в 64-битные слова.
+    // Для идентификаторов на 20-34 бита это в 2-3 раза меньше np::vector<uint64_t>; чтение - два
+    // соседних слова, сдвиг и маска, массовая распаковка (unpack) идёт через SIMD-ядра.
+    // За последним полем лежит лишнее нулевое слово, чтобы чтение пары слов не выходило за буфер;
+    // биты за size() нулевые. Пустой вектор (новый, очищенный или перемещённый) может не держать
+    // ни одного слова: заполнитель появляется при первой записи, поэтому конструктор по умолчанию
+    // и перемещение не выделяют память и не бросают.
+    template <unsigned Bits, typename Allocator = std::allocator<std::uint64_t>>
+    class packed_vector {
+        static_assert(Bits >= 1 && Bits <= 64, "packed_vector width must be in [1, 64]");
+
+        using word_type = std::uint64_t;
+        using storage_type = vector<word_type, Allocator>;
+
+    public:
+        using value_type = std::uint64_t;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr unsigned width = Bits;
+        static constexpr value_type max_value = detail::low_bits_mask(Bits);
+
+        // Ссылка на поле: запись проверяет, что значение помещается в Bits бит
+        class reference {
+        public:
+            reference(packed_vector* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+
+            reference(const reference&) noexcept = default;
+
+            reference& operator=(const value_type value) {
+                owner_->set(index_, value);
+                return *this;
+            }
+
+            reference& operator=(const reference& other) {
+                return *this = static_cast<value_type>(other);
+            }
+
+            const reference& operator=(const value_type value) const {
+                owner_->set(index_, value);
+                return *this;
+            }
+
+            operator value_type() const noexcept {
+                return std::as_const(*owner_)[index_];
+            }
+
+            friend void swap(reference lhs, reference rhs) {
+                const value_type temp = lhs;
+                lhs = static_cast<value_type>(rhs);
+                rhs = temp;
+            }
+
+        private:
+            packed_vector* owner_;
+            size_type index_;
+        };
+
+        using const_reference = value_type;
+
+    private:
+        template <bool is_const>
+        class base_iterator {
+        public:
+            using owner_type = std::conditional_t<is_const, const packed_vector, packed_vector>;
+            using reference_type = std::conditional_t<is_const, typename packed_vector::value_type, typename packed_vector::reference>;
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::uint64_t;
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+
+            owner_type* owner_ = nullptr;
+            size_type index_ = 0;
+
+            /***************************/
+            base_iterator() noexcept = default;
+
+            base_iterator(owner_type* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+
+            // iterator -> const_iterator
+            template <bool other_const> requires (is_const && !other_const)
+            base_iterator(const base_iterator<other_const>& other) noexcept : owner_(other.owner_), index_(other.index_) {}
+            /***************************/
+
+
+            /***************************/
+            reference_type operator*() const {
+                return (*owner_)[index_];
+            }
+
+            reference_type operator[](const difference_type index) const {
+                return (*owner_)[index_ + index];
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator& operator++() noexcept {
+                ++index_;
+                return *this;
+            }
+
+            base_iterator& operator--() noexcept {
+                --index_;
+                return *this;
+            }
+
+            base_iterator operator++(int) noexcept {
+                base_iterator temp = *this;
+                ++index_;
+                return temp;
+            }
+
+            base_iterator operator--(int) noexcept {
+                base_iterator temp = *this;
+                --index_;
+                return temp;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator operator+(const difference_type value) const noexcept {
+                return base_iterator(owner_, index_ + value);
+            }
+
+            friend base_iterator operator+(const difference_type value, const base_iterator& it) noexcept {
+                return it + value;
+            }
+
+            base_iterator operator-(const difference_type value) const noexcept {
+                return base_iterator(owner_, index_ - value);
+            }
+
+            difference_type operator-(const base_iterator& other) const noexcept {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            base_iterator& operator+=(const difference_type value) noexcept {
+                index_ += value;
+                return *this;
+            }
+
+            base_iterator& operator-=(const difference_type value) noexcept {
+                index_ -= value;
+                return *this;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            bool operator==(const base_iterator& other) const noexcept {
+                return index_ == other.index_;
+            }
+
+            auto operator<=>(const base_iterator& other) const noexcept {
+                return index_ <=> other.index_;
+            }
+            /***************************/
+        };
+
+    public:
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    public:
+        packed_vector() noexcept(noexcept(allocator_type())) : packed_vector(allocator_type()) {}
+
+        explicit packed_vector(const allocator_type& alloc) noexcept : words_(alloc) {}
+
+        explicit packed_vector(const size_type n, const allocator_type& alloc = allocator_type()) : packed_vector(n, 0, alloc) {}
+
+        packed_vector(const size_type n, const value_type value, const allocator_type& alloc = allocator_type()) : packed_vector(alloc) {
+            resize(n, value);
+        }
+
+        packed_vector(const std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type())
+            : packed_vector(list.begin(), list.end(), alloc) {}
+
+        template <std::input_iterator InputIt>
+        packed_vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : packed_vector(alloc) {
+            if constexpr (std::forward_iterator<InputIt>) {
+                reserve(static_cast<size_type>(std::distance(first, last)));
+            }
+
+            for (; first != last; ++first) {
+                push_back(static_cast<value_type>(*first));
+            }
+        }
+
+        packed_vector(const packed_vector&) = default;
+        packed_vector& operator=(const packed_vector&) = default;
+
+        // Перемещённый вектор остаётся пустым и без слов
+        packed_vector(packed_vector&& other) noexcept : words_(std::move(other.words_)), size_(std::exchange(other.size_, 0)) {}
+
+        packed_vector& operator=(packed_vector&& other) noexcept(std::is_nothrow_move_assignable_v<storage_type>) {
+            if (this != &other) {
+                words_ = std::move(other.words_);
+                size_ = std::exchange(other.size_, 0);
+                // С неравными аллокаторами слова перемещаются по одному и остаются у источника
+                other.words_.clear();
+            }
+
+            return *this;
+        }
+
+        ~packed_vector() = default;
+
+        void swap(packed_vector& other) noexcept(noexcept(words_.swap(other.words_))) {
+            words_.swap(other.words_);
+            std::swap(size_, other.size_);
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept {
+            return words_.get_allocator();
+        }
+
+        /***************************/
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(this, size_); }
+        const_iterator end() const noexcept { return const_iterator(this, size_); }
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+        /***************************/
+
+        [[nodiscard]] size_type size() const noexcept {
+            return size_;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept {
+            return words_.capacity() == 0 ? 0 : (words_.capacity() - 1) * 64 / Bits;
+        }
+
+        // Байты под упакованные поля, включая слово-заполнитель
+        [[nodiscard]] size_type bytes() const noexcept {
+            return words_.size() * sizeof(word_type);
+        }
+
+        void reserve(const size_type new_capacity) {
+            words_.reserve(words_for_(new_capacity));
+        }
+
+        void shrink_to_fit() {
+            words_.shrink_to_fit();
+        }
+
+        void clear() noexcept {
+            words_.clear();
+            size_ = 0;
+        }
+
+        void push_back(const value_type value) {
+            check_value_(value);
+            // Новые слова - через push_back: resize резервирует ровно столько, сколько просят.
+            // У вектора без слов сначала появляется и заполнитель
+            while (words_for_(size_ + 1) > words_.size()) {
+                words_.push_back(0);
+            }
+            detail::deposit_bits(words_.data(), size_ * Bits, Bits, value);
+            ++size_;
+        }
+
+        void pop_back() {
+            truncate_(size_ - 1);
+        }
+
+        void resize(const size_type count, const value_type value = 0) {
+            check_value_(value);
+
+            if (count <= size_) {
+                truncate_(count);
+                return;
+            }
+
+            const size_type old_size = size_;
+            words_.resize(words_for_(count));
+            size_ = count;
+
+            if (value != 0) {
+                for (size_type i = old_size; i < count; ++i) {
+                    detail::deposit_bits(words_.data(), i * Bits, Bits, value);
+                }
+            }
+        }
+
+        /***************************/
+        reference operator[](const size_type index) noexcept {
+            return reference(this, index);
+        }
+
+        const_reference operator[](const size_type index) const noexcept {
+            return simd::detail::extract_bits(std::to_address(words_.data()), index * Bits, Bits);
+        }
+
+        reference at(const size_type index) {
+            check_index_(index);
+            return (*this)[index];
+        }
+
+        const_reference at(const size_type index) const {
+            check_index_(index);
+            return (*this)[index];
+        }
+
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+
+        reference back() { return (*this)[size_ - 1]; }
+        const_reference back() const { return (*this)[size_ - 1]; }
+
+        void set(const size_type index, const value_type value) {
+            check_value_(value);
+            detail::deposit_bits(words_.data(), index * Bits, Bits, value);
+        }
+        /***************************/
+
+        // Распаковка count значений начиная с first в out (SIMD)
+        void unpack(const size_type first, const size_type count, value_type* out) const noexcept {
+            simd::unpack(std::to_address(words_.data()), first, Bits, 0, out, count);
+        }
+
+        // Сырые слова, включая слово-заполнитель; у пустого вектора их может не быть
+        [[nodiscard]] std::span<const word_type> words() const noexcept {
+            return {std::to_address(words_.data()), words_.size()};
+        }
+
+        friend bool operator==(const packed_vector& lhs, const packed_vector& rhs) {
+            // Пустые равны независимо от того, есть ли у них заполнитель
+            return lhs.size_ == rhs.size_ && (lhs.size_ == 0 || lhs.words_ == rhs.words_);
+        }
+
+    private:
+        static constexpr size_type words_for_(const size_type count) noexcept {
+            return (count * Bits + 63) / 64 + 1;
+        }
+
+        static void check_value_(const value_type value) {
+            if (value > max_value) {
+                throw std::out_of_range("Value does not fit in packed width");
+            }
+        }
+
+        // Отрезает слова за count и обнуляет биты за последним полем
+        void truncate_(const size_type count) {
+            // Пустому вектору заполнитель не нужен: resize(0) у пустого не выделяет память
+            if (count == 0) {
+                clear();
+                return;
+            }
+
+            words_.resize(words_for_(count));
+            size_ = count;
+
+            const size_type bits = count * Bits;
+            if (bits % 64 != 0) {
+                words_[bits / 64] &= detail::low_bits_mask(static_cast<unsigned>(bits % 64));
+            }
+            words_.back() = 0;
+        }
+
+        void check_index_(const size_type index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+        }
+
+        storage_type words_;
+        size_type size_ = 0;
+    };
+
+    static_assert(std::random_access_iterator<packed_vector<20>::iterator> && std::random_access_iterator<packed_vector<20>::const_iterator>);
+}
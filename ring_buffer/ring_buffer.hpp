@@ -0,0 +1,695 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/vector.hpp"
+
+namespace np {
+    // Поведение push_* в заполненный буфер
+    enum class ring_mode {
+        growable,   // ёмкость удваивается, элементы переносятся в новый блок
+        fixed,      // std::length_error, буфер не меняется
+        overwrite   // вытесняется элемент с противоположного конца: push_back - самый старый (front)
+    };
+
+    // Кольцевой буфер (двусторонняя очередь) на одном блоке от аллокатора. Ёмкость - степень двойки,
+    // позиция элемента - (head + index) & (capacity - 1), так что вставка и удаление с обоих концов -
+    // O(1) без сдвига остальных элементов, в отличие от erase(begin()) у np::vector.
+    //
+    // Содержимое лежит в блоке не более чем двумя непрерывными кусками: first_span() от головы
+    // до конца блока и second_span() от начала блока. Массовое копирование - два memcpy,
+    // linearize() сводит содержимое к одному куску.
+    template <typename T, typename Allocator = std::allocator<T>, typename Stats = no_stats>
+    class ring_buffer {
+        using allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+        using allocator_type = Allocator;
+        using stats_type = Stats;
+        using value_type = T;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = typename allocator_traits::pointer;
+        using const_pointer = typename allocator_traits::const_pointer;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+    private:
+        template <bool is_const>
+        class base_iterator {
+            using owner_type = std::conditional_t<is_const, const ring_buffer, ring_buffer>;
+
+        public:
+            using pointer_type = std::conditional_t<is_const, const_pointer, pointer>;
+            using reference_type = std::conditional_t<is_const, const_reference, reference>;
+            using difference_type = std::ptrdiff_t;
+            using value_type = T;
+            using iterator_category = std::random_access_iterator_tag;
+
+            owner_type* owner_ = nullptr;
+            size_type index_ = 0;
+
+            /***************************/
+            base_iterator() noexcept = default;
+
+            base_iterator(owner_type* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+
+            // iterator -> const_iterator
+            template <bool other_const> requires (is_const && !other_const)
+            base_iterator(const base_iterator<other_const>& other) noexcept : owner_(other.owner_), index_(other.index_) {}
+            /***************************/
+
+
+            /***************************/
+            reference_type operator*() const {
+                return (*owner_)[index_];
+            }
+
+            pointer_type operator->() const {
+                return std::addressof((*owner_)[index_]);
+            }
+
+            reference_type operator[](const difference_type offset) const {
+                return (*owner_)[index_ + offset];
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+
+            base_iterator& operator--() {
+                --index_;
+                return *this;
+            }
+
+            base_iterator operator++(int) {
+                base_iterator temp = *this;
+                ++index_;
+                return temp;
+            }
+
+            base_iterator operator--(int) {
+                base_iterator temp = *this;
+                --index_;
+                return temp;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator operator+(const difference_type value) const {
+                return base_iterator(owner_, index_ + value);
+            }
+
+            friend base_iterator operator+(const difference_type value, const base_iterator& it) {
+                return it + value;
+            }
+
+            base_iterator operator-(const difference_type value) const {
+                return base_iterator(owner_, index_ - value);
+            }
+
+            difference_type operator-(const base_iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            base_iterator& operator+=(const difference_type value) {
+                index_ += value;
+                return *this;
+            }
+
+            base_iterator& operator-=(const difference_type value) {
+                index_ -= value;
+                return *this;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            bool operator==(const base_iterator& other) const {
+                return index_ == other.index_;
+            }
+
+            auto operator<=>(const base_iterator& other) const {
+                return index_ <=> other.index_;
+            }
+            /***************************/
+        };
+
+    public:
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    public:
+        ring_buffer() noexcept = default;
+
+        explicit ring_buffer(const allocator_type& alloc) noexcept : allocator_(alloc) {}
+
+        // Ёмкость округляется вверх до степени двойки
+        ring_buffer(const ring_mode mode, const size_type capacity, const allocator_type& alloc = allocator_type()) : mode_(mode), allocator_(alloc) {
+            reserve(capacity);
+        }
+
+        ring_buffer(const std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) : ring_buffer(alloc) {
+            reserve(list.size());
+            for (const auto& value : list) {
+                push_back(value);
+            }
+        }
+
+        template <std::input_iterator InputIt>
+        ring_buffer(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : ring_buffer(alloc) {
+            if constexpr (std::forward_iterator<InputIt>) {
+                reserve(static_cast<size_type>(std::distance(first, last)));
+            }
+
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        // Копия той же ёмкости и в том же режиме, но уже с головой в начале блока
+        ring_buffer(const ring_buffer& other) : mode_(other.mode_), allocator_(allocator_traits::select_on_container_copy_construction(other.allocator_)) {
+            reserve(other.capacity_);
+            for (size_type index = 0; index < other.size_; ++index) {
+                push_back(other[index]);
+            }
+            stats_.on_copy(other.size_);
+        }
+
+        ring_buffer(ring_buffer&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)), head_(std::exchange(other.head_, 0)), size_(std::exchange(other.size_, 0)),
+              capacity_(std::exchange(other.capacity_, 0)), mode_(other.mode_), allocator_(std::move(other.allocator_)) {
+            if (data_ != nullptr) {
+                stats_.on_adopt(capacity_ * sizeof(value_type));
+                other.stats_.on_disown(capacity_ * sizeof(value_type));
+            }
+        }
+
+        // Аллокатор - по правилам propagate_on_container_*, как у np::vector; режим копируется всегда
+        ring_buffer& operator=(const ring_buffer& other) {
+            if (this != &other) {
+                if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+                    // Блок выделен старым аллокатором - вернуть его ему, пока он ещё наш
+                    if (allocator_ != other.allocator_) {
+                        release_();
+                    }
+
+                    allocator_ = other.allocator_;
+                }
+
+                assign_(other, [&other](const size_type index) -> const_reference { return other[index]; });
+                stats_.on_copy(other.size_);
+            }
+
+            return *this;
+        }
+
+        ring_buffer& operator=(ring_buffer&& other) noexcept(allocator_traits::propagate_on_container_move_assignment::value
+                                                             || allocator_traits::is_always_equal::value) {
+            if (this != &other) {
+                if constexpr (!allocator_traits::propagate_on_container_move_assignment::value && !allocator_traits::is_always_equal::value) {
+                    // Аллокатор остаётся свой, и если он не равен чужому - перемещаем поэлементно
+                    if (allocator_ != other.allocator_) {
+                        assign_(other, [&other](const size_type index) -> value_type&& { return std::move(other[index]); });
+                        stats_.on_move(other.size_);
+                        other.clear();
+                        return *this;
+                    }
+                }
+
+                release_();
+
+                if constexpr (allocator_traits::propagate_on_container_move_assignment::value) {
+                    allocator_ = std::move(other.allocator_);
+                }
+
+                if (other.data_ != nullptr) {
+                    stats_.on_adopt(other.capacity_ * sizeof(value_type));
+                    other.stats_.on_disown(other.capacity_ * sizeof(value_type));
+                }
+
+                data_ = std::exchange(other.data_, nullptr);
+                head_ = std::exchange(other.head_, 0);
+                size_ = std::exchange(other.size_, 0);
+                capacity_ = std::exchange(other.capacity_, 0);
+                mode_ = other.mode_;
+            }
+
+            return *this;
+        }
+
+        ~ring_buffer() {
+            release_();
+        }
+
+        // Без propagate_on_container_swap аллокаторы обязаны быть равны, как и у np::vector
+        void swap(ring_buffer& other) noexcept {
+            using std::swap;
+            if constexpr (allocator_traits::propagate_on_container_swap::value) {
+                swap(allocator_, other.allocator_);
+            }
+
+            stats_.on_disown(capacity_ * sizeof(value_type));
+            stats_.on_adopt(other.capacity_ * sizeof(value_type));
+            other.stats_.on_disown(other.capacity_ * sizeof(value_type));
+            other.stats_.on_adopt(capacity_ * sizeof(value_type));
+
+            swap(data_, other.data_);
+            swap(head_, other.head_);
+            swap(size_, other.size_);
+            swap(capacity_, other.capacity_);
+            swap(mode_, other.mode_);
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept {
+            return allocator_;
+        }
+
+        // Счётчики политики Stats; с no_stats - нулевой снимок
+        [[nodiscard]] stats_snapshot stats() const noexcept {
+            stats_snapshot snapshot = stats_.snapshot();
+            if constexpr (stats_type::enabled) {
+                snapshot.bytes_used = size_ * sizeof(value_type);
+            }
+
+            return snapshot;
+        }
+
+        stats_type& stats_policy() noexcept { return stats_; }
+        const stats_type& stats_policy() const noexcept { return stats_; }
+
+        [[nodiscard]] ring_mode mode() const noexcept { return mode_; }
+        void set_mode(const ring_mode mode) noexcept { mode_ = mode; }
+
+        /***************************/
+        // Явный рост работает в любом режиме: fixed и overwrite запрещают только неявный.
+        // Ёмкость округляется вверх до степени двойки
+        void reserve(const size_type new_capacity) {
+            if (new_capacity <= capacity_) {
+                return;
+            }
+
+            if (new_capacity > max_size()) {
+                throw std::length_error("ring_buffer is too long");
+            }
+
+            reallocate_(std::bit_ceil(new_capacity));
+        }
+
+        void shrink_to_fit() {
+            const size_type new_capacity = size_ != 0 ? std::bit_ceil(size_) : 0;
+            if (new_capacity != capacity_) {
+                reallocate_(new_capacity);
+            }
+        }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        void push_back(value_type&& value) {
+            emplace_back(std::move(value));
+        }
+
+        void push_front(const_reference value) {
+            emplace_front(value);
+        }
+
+        void push_front(value_type&& value) {
+            emplace_front(std::move(value));
+        }
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args) {
+            if (size_ == capacity_) {
+                if (mode_ == ring_mode::growable) {
+                    // Новый элемент строится в новом блоке до переноса старых: аргумент может ссылаться на них
+                    grow_(size_, std::forward<Args>(args)...);
+                    ++size_;
+                    return back();
+                }
+
+                // Значение строится заранее: аргумент может ссылаться на вытесняемый элемент
+                value_type temp(std::forward<Args>(args)...);
+                make_room_();
+                pop_front();
+
+                allocator_traits::construct(allocator_, slot_(size_), std::move(temp));
+                ++size_;
+                return back();
+            }
+
+            allocator_traits::construct(allocator_, slot_(size_), std::forward<Args>(args)...);
+            ++size_;
+            return back();
+        }
+
+        template <typename... Args>
+        reference emplace_front(Args&&... args) {
+            if (size_ == capacity_) {
+                if (mode_ == ring_mode::growable) {
+                    // Голова встаёт на последнюю ячейку нового блока, старые элементы - с нуля
+                    grow_(capacity_ != 0 ? capacity_ * 2 - 1 : 0, std::forward<Args>(args)...);
+                    head_ = capacity_ - 1;
+                    ++size_;
+                    return front();
+                }
+
+                value_type temp(std::forward<Args>(args)...);
+                make_room_();
+                pop_back();
+
+                head_ = (head_ - 1) & mask_();
+                allocator_traits::construct(allocator_, std::to_address(data_ + head_), std::move(temp));
+                ++size_;
+                return front();
+            }
+
+            const size_type new_head = (head_ - 1) & mask_();
+            allocator_traits::construct(allocator_, std::to_address(data_ + new_head), std::forward<Args>(args)...);
+            head_ = new_head;
+            ++size_;
+            return front();
+        }
+
+        void pop_back() {
+            allocator_traits::destroy(allocator_, slot_(--size_));
+        }
+
+        void pop_front() {
+            allocator_traits::destroy(allocator_, std::to_address(data_ + head_));
+            head_ = (head_ + 1) & mask_();
+            --size_;
+        }
+
+        // Снятие count элементов с головы - сдвиг окна без поэлементного pop_front
+        void pop_front(const size_type count) {
+            const auto [first, second] = spans();
+            const size_type from_first = std::min(count, first.size());
+
+            detail::destroy_n(allocator_, first.data(), from_first);
+            detail::destroy_n(allocator_, second.data(), count - from_first);
+
+            head_ = size_ != count ? (head_ + count) & mask_() : 0;
+            size_ -= count;
+        }
+
+        void pop_back(const size_type count) {
+            for (size_type i = 0; i < count; ++i) {
+                pop_back();
+            }
+        }
+
+        // Блок остаётся, голова возвращается в начало
+        void clear() noexcept {
+            const auto [first, second] = spans();
+            detail::destroy_n(allocator_, first.data(), first.size());
+            detail::destroy_n(allocator_, second.data(), second.size());
+
+            head_ = 0;
+            size_ = 0;
+        }
+        /***************************/
+
+
+
+        /***************************/
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+        [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] bool full() const noexcept { return size_ == capacity_; }
+
+        [[nodiscard]] size_type max_size() const noexcept {
+            return std::bit_floor(std::min<size_type>(allocator_traits::max_size(allocator_), std::numeric_limits<difference_type>::max()));
+        }
+
+        reference operator[](const size_type index) noexcept { return *slot_(index); }
+        const_reference operator[](const size_type index) const noexcept { return *slot_(index); }
+
+        reference at(const size_type index) {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return *slot_(index);
+        }
+
+        const_reference at(const size_type index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return *slot_(index);
+        }
+
+        reference front() { return *slot_(0); }
+        const_reference front() const { return *slot_(0); }
+
+        reference back() { return *slot_(size_ - 1); }
+        const_reference back() const { return *slot_(size_ - 1); }
+        /***************************/
+
+
+
+        /***************************/
+        // Непрерывные куски содержимого в порядке элементов; второй пуст, если буфер не перевёрнут
+        std::span<value_type> first_span() noexcept {
+            return {std::to_address(data_) + head_, first_size_()};
+        }
+
+        std::span<const value_type> first_span() const noexcept {
+            return {std::to_address(data_) + head_, first_size_()};
+        }
+
+        std::span<value_type> second_span() noexcept {
+            return {std::to_address(data_), size_ - first_size_()};
+        }
+
+        std::span<const value_type> second_span() const noexcept {
+            return {std::to_address(data_), size_ - first_size_()};
+        }
+
+        std::pair<std::span<value_type>, std::span<value_type>> spans() noexcept {
+            return {first_span(), second_span()};
+        }
+
+        std::pair<std::span<const value_type>, std::span<const value_type>> spans() const noexcept {
+            return {first_span(), second_span()};
+        }
+
+        // Копирует содержимое по порядку в out: два вызова std::copy по непрерывным кускам
+        template <typename OutputIt>
+        OutputIt copy_to(OutputIt out) const {
+            const auto [first, second] = spans();
+            out = std::copy(first.begin(), first.end(), out);
+            return std::copy(second.begin(), second.end(), out);
+        }
+
+        // Переносит перевёрнутое содержимое в новый блок той же ёмкости с головой в начале.
+        // Ссылки и итераторы после этого недействительны
+        std::span<value_type> linearize() {
+            if (head_ + size_ > capacity_) {
+                reallocate_(capacity_);
+            }
+
+            return first_span();
+        }
+        /***************************/
+
+
+
+        /***************************/
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(this, size_); }
+        const_iterator end() const noexcept { return const_iterator(this, size_); }
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+        /***************************/
+
+    private:
+        size_type mask_() const noexcept {
+            return capacity_ - 1;
+        }
+
+        pointer slot_(const size_type index) const noexcept {
+            return data_ + ((head_ + index) & mask_());
+        }
+
+        size_type first_size_() const noexcept {
+            return std::min(size_, capacity_ - head_);
+        }
+
+        pointer allocate_(const size_type capacity) {
+            pointer ptr = allocator_traits::allocate(allocator_, capacity);
+            stats_.on_allocate(capacity * sizeof(value_type));
+            return ptr;
+        }
+
+        void deallocate_(pointer ptr, const size_type capacity) noexcept {
+            if (ptr != nullptr) {
+                allocator_traits::deallocate(allocator_, ptr, capacity);
+                stats_.on_deallocate(capacity * sizeof(value_type));
+            }
+        }
+
+        void release_() noexcept {
+            clear();
+            deallocate_(data_, capacity_);
+
+            data_ = nullptr;
+            capacity_ = 0;
+        }
+
+        // Поэлементное присваивание: содержимое заменяется, блок переиспользуется, если хватает ёмкости
+        template <typename Get>
+        void assign_(const ring_buffer& other, Get get) {
+            clear();
+            mode_ = other.mode_;
+            reserve(other.size_);
+
+            for (; size_ != other.size_; ++size_) {
+                allocator_traits::construct(allocator_, slot_(size_), get(size_));
+            }
+        }
+
+        // Заполненный буфер в режиме fixed (и overwrite без блока) новый элемент не принимает
+        void make_room_() const {
+            if (mode_ == ring_mode::fixed || capacity_ == 0) {
+                throw std::length_error("ring_buffer is full");
+            }
+        }
+
+        // Переносит оба куска в dest подряд. Если перенос может бросить (копирование вместо
+        // перемещения), исходные элементы уничтожаются только после успешного копирования обоих
+        void relocate_to_(pointer dest) {
+            const size_type first = first_size_();
+            const size_type second = size_ - first;
+
+            if constexpr (is_trivially_relocatable_v<value_type> || std::is_nothrow_move_constructible_v<value_type>) {
+                detail::uninitialized_relocate_n(allocator_, data_ + head_, first, dest);
+                detail::uninitialized_relocate_n(allocator_, data_, second, dest + first);
+            }
+            else {
+                detail::uninitialized_move_if_noexcept_n(allocator_, data_ + head_, first, dest);
+
+                try {
+                    detail::uninitialized_move_if_noexcept_n(allocator_, data_, second, dest + first);
+                } catch (...) {
+                    detail::destroy_n(allocator_, dest, first);
+                    throw;
+                }
+
+                detail::destroy_n(allocator_, data_ + head_, first);
+                detail::destroy_n(allocator_, data_, second);
+            }
+        }
+
+        void adopt_block_(pointer new_arr, const size_type new_capacity) noexcept {
+            deallocate_(data_, capacity_);
+            stats_.on_reallocation();
+            stats_.on_move(size_);
+
+            data_ = new_arr;
+            capacity_ = new_capacity;
+            head_ = 0;
+        }
+
+        void reallocate_(const size_type new_capacity) {
+            pointer new_arr = new_capacity != 0 ? allocate_(new_capacity) : nullptr;
+
+            try {
+                relocate_to_(new_arr);
+            } catch (...) {
+                deallocate_(new_arr, new_capacity);
+                throw;
+            }
+
+            adopt_block_(new_arr, new_capacity);
+        }
+
+        // Удвоение ёмкости: новый элемент строится в ячейке index нового блока,
+        // старые переносятся в его начало
+        template <typename... Args>
+        void grow_(const size_type index, Args&&... args) {
+            if (capacity_ == max_size()) {
+                throw std::length_error("ring_buffer is too long");
+            }
+
+            const size_type new_capacity = capacity_ != 0 ? capacity_ * 2 : 1;
+            pointer new_arr = allocate_(new_capacity);
+
+            try {
+                allocator_traits::construct(allocator_, std::to_address(new_arr + index), std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate_(new_arr, new_capacity);
+                throw;
+            }
+
+            try {
+                relocate_to_(new_arr);
+            } catch (...) {
+                allocator_traits::destroy(allocator_, std::to_address(new_arr + index));
+                deallocate_(new_arr, new_capacity);
+                throw;
+            }
+
+            adopt_block_(new_arr, new_capacity);
+        }
+
+        pointer data_ = nullptr;
+        size_type head_ = 0;
+        size_type size_ = 0;
+        size_type capacity_ = 0;
+        ring_mode mode_ = ring_mode::growable;
+        [[no_unique_address]] allocator_type allocator_;
+        [[no_unique_address]] stats_type stats_;
+    };
+
+    static_assert(std::random_access_iterator<ring_buffer<int>::iterator>);
+    static_assert(std::random_access_iterator<ring_buffer<int>::const_iterator>);
+
+    template <typename T, typename Allocator, typename Stats>
+    bool operator==(const ring_buffer<T, Allocator, Stats>& lhs, const ring_buffer<T, Allocator, Stats>& rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <typename T, typename Allocator, typename Stats>
+    void swap(ring_buffer<T, Allocator, Stats>& lhs, ring_buffer<T, Allocator, Stats>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    template <typename T, typename Allocator, typename Stats>
+    struct is_trivially_relocatable<ring_buffer<T, Allocator, Stats>>
+        : std::bool_constant<is_trivially_relocatable_v<Allocator> && is_trivially_relocatable_v<Stats>> {};
+}
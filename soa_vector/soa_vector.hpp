@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/aligned_allocator.hpp"
+#include "../vector/vector.hpp"
+
+namespace np {
+    // Структура массивов: каждое поле Ts лежит в своём непрерывном столбце, выровненном по 64 байтам.
+    // Цикл по одному полю читает только его байты, а column<I>() отдаёт столбец как span для SIMD.
+    // Столбцы - это np::vector с общей ёмкостью: рост идёт по growth_2x одновременно во всех,
+    // поэтому добавление строки либо проходит целиком, либо не меняет ни одного столбца.
+    template <typename... Ts>
+    class soa_vector {
+        static_assert(sizeof...(Ts) != 0, "soa_vector needs at least one column");
+
+        template <typename T>
+        using column_type = vector<T, aligned_allocator<T>>;
+
+        using growth_policy = growth_2x;
+
+        static constexpr std::size_t columns_count_ = sizeof...(Ts);
+
+    public:
+        using value_type = std::tuple<Ts...>;
+        using reference = std::tuple<Ts&...>;
+        using const_reference = std::tuple<const Ts&...>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template <std::size_t I>
+        using column_value_type = std::tuple_element_t<I, value_type>;
+
+    private:
+        // Итератор по строкам; разыменование даёт кортеж ссылок, как у std::views::zip
+        template <bool is_const>
+        class base_iterator {
+            using owner_type = std::conditional_t<is_const, const soa_vector, soa_vector>;
+
+        public:
+            using reference_type = std::conditional_t<is_const, const_reference, reference>;
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::tuple<Ts...>;
+            using iterator_category = std::input_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+
+            owner_type* owner_ = nullptr;
+            size_type index_ = 0;
+
+            /***************************/
+            base_iterator() noexcept = default;
+
+            base_iterator(owner_type* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+
+            // iterator -> const_iterator
+            template <bool other_const> requires (is_const && !other_const)
+            base_iterator(const base_iterator<other_const>& other) noexcept : owner_(other.owner_), index_(other.index_) {}
+            /***************************/
+
+
+            /***************************/
+            reference_type operator*() const {
+                return (*owner_)[index_];
+            }
+
+            reference_type operator[](const difference_type offset) const {
+                return (*owner_)[index_ + offset];
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+
+            base_iterator& operator--() {
+                --index_;
+                return *this;
+            }
+
+            base_iterator operator++(int) {
+                base_iterator temp = *this;
+                ++index_;
+                return temp;
+            }
+
+            base_iterator operator--(int) {
+                base_iterator temp = *this;
+                --index_;
+                return temp;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator operator+(const difference_type value) const {
+                return base_iterator(owner_, index_ + value);
+            }
+
+            friend base_iterator operator+(const difference_type value, const base_iterator& it) {
+                return it + value;
+            }
+
+            base_iterator operator-(const difference_type value) const {
+                return base_iterator(owner_, index_ - value);
+            }
+
+            difference_type operator-(const base_iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            base_iterator& operator+=(const difference_type value) {
+                index_ += value;
+                return *this;
+            }
+
+            base_iterator& operator-=(const difference_type value) {
+                index_ -= value;
+                return *this;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            bool operator==(const base_iterator& other) const {
+                return index_ == other.index_;
+            }
+
+            auto operator<=>(const base_iterator& other) const {
+                return index_ <=> other.index_;
+            }
+            /***************************/
+        };
+
+    public:
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+    public:
+        soa_vector() noexcept = default;
+
+        explicit soa_vector(const size_type n) {
+            resize(n);
+        }
+
+        // Столбец I целиком, например для SIMD-цикла по одному полю
+        template <std::size_t I>
+        std::span<column_value_type<I>> column() noexcept {
+            auto& column = std::get<I>(columns_);
+            return {std::to_address(column.data()), column.size()};
+        }
+
+        template <std::size_t I>
+        std::span<const column_value_type<I>> column() const noexcept {
+            const auto& column = std::get<I>(columns_);
+            return {std::to_address(column.data()), column.size()};
+        }
+
+        void reserve(const size_type new_capacity) {
+            if (new_capacity > capacity()) {
+                for_each_column_([new_capacity](auto& column) { column.reserve(new_capacity); });
+            }
+        }
+
+        void push_back(const Ts&... values) {
+            emplace_back(values...);
+        }
+
+        void push_back(Ts&&... values) {
+            emplace_back(std::move(values)...);
+        }
+
+        // По одному аргументу на столбец; каждый конструирует своё поле
+        template <typename... Args> requires (sizeof...(Args) == columns_count_)
+        reference emplace_back(Args&&... args) {
+            if (size_ == capacity()) {
+                // Аргументы могут ссылаться на поля самого вектора, а reserve переносит столбцы
+                value_type row(std::forward<Args>(args)...);
+                reserve(growth_policy::next_capacity(std::allocator<std::byte>(), capacity(), size_ + 1));
+                emplace_row_(std::index_sequence_for<Ts...>(), std::move(row));
+            }
+            else {
+                emplace_row_(std::index_sequence_for<Ts...>(), std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            ++size_;
+            return (*this)[size_ - 1];
+        }
+
+        void pop_back() {
+            for_each_column_([](auto& column) { column.pop_back(); });
+            --size_;
+        }
+
+        void clear() noexcept {
+            for_each_column_([](auto& column) { column.clear(); });
+            size_ = 0;
+        }
+
+        void resize(const size_type count) {
+            reserve(count);
+            try {
+                for_each_column_([count](auto& column) { column.resize(count); });
+            } catch (...) {
+                for_each_column_([this](auto& column) { column.resize(std::min(column.size(), size_)); });
+                throw;
+            }
+
+            size_ = count;
+        }
+
+        void shrink_to_fit() {
+            for_each_column_([](auto& column) { column.shrink_to_fit(); });
+        }
+
+        void swap(soa_vector& other) noexcept {
+            columns_.swap(other.columns_);
+            std::swap(size_, other.size_);
+        }
+
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+        [[nodiscard]] size_type capacity() const noexcept { return std::get<0>(columns_).capacity(); }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        reference operator[](const size_type index) noexcept {
+            return std::apply([index](auto&... column) { return reference(column[index]...); }, columns_);
+        }
+
+        const_reference operator[](const size_type index) const noexcept {
+            return std::apply([index](const auto&... column) { return const_reference(column[index]...); }, columns_);
+        }
+
+        reference at(const size_type index) {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return (*this)[index];
+        }
+
+        const_reference at(const size_type index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return (*this)[index];
+        }
+
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+
+        reference back() { return (*this)[size_ - 1]; }
+        const_reference back() const { return (*this)[size_ - 1]; }
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(this, size_); }
+        const_iterator end() const noexcept { return const_iterator(this, size_); }
+        const_iterator cend() const noexcept { return end(); }
+
+    private:
+        template <typename Fn>
+        void for_each_column_(Fn&& fn) {
+            std::apply([&fn](auto&... column) { (fn(column), ...); }, columns_);
+        }
+
+        // Ёмкость уже есть во всех столбцах; если конструктор поля бросил, заполненные откатываются
+        template <std::size_t... I, typename Row>
+        void emplace_row_(std::index_sequence<I...>, Row&& row) {
+            std::size_t done = 0;
+            try {
+                ((std::get<I>(columns_).emplace_back(std::get<I>(std::forward<Row>(row))), ++done), ...);
+            } catch (...) {
+                ((I < done ? std::get<I>(columns_).pop_back() : void()), ...);
+                throw;
+            }
+        }
+
+        std::tuple<column_type<Ts>...> columns_;
+        size_type size_ = 0;
+    };
+
+    template <typename... Ts>
+    void swap(soa_vector<Ts...>& lhs, soa_vector<Ts...>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/vector.hpp"
+
+namespace np {
+    namespace detail {
+        // Около 4 КиБ на блок, округлено вниз до степени двойки
+        template <typename T>
+        inline constexpr std::size_t default_chunk_size = std::bit_floor(std::max<std::size_t>(1, 4096 / sizeof(T)));
+    }
+
+    // Вектор из блоков фиксированного размера и таблицы указателей на них. Рост добавляет блок и
+    // никогда не перемещает элементы: указатели, ссылки и индексы остаются валидными, а пикового
+    // удвоения памяти, как при переезде np::vector, нет. Доступ по индексу - сдвиг и маска.
+    template <typename T, typename Allocator = std::allocator<T>, std::size_t ChunkSize = detail::default_chunk_size<T>>
+    class stable_vector {
+        static_assert(std::has_single_bit(ChunkSize), "ChunkSize must be a power of two");
+
+        using allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+        using allocator_type = Allocator;
+        using value_type = T;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using pointer = typename allocator_traits::pointer;
+        using const_pointer = typename allocator_traits::const_pointer;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr size_type chunk_size = ChunkSize;
+
+    private:
+        static constexpr size_type chunk_shift_ = std::countr_zero(ChunkSize);
+        static constexpr size_type chunk_mask_ = ChunkSize - 1;
+
+        using chunk_table = vector<pointer, typename allocator_traits::template rebind_alloc<pointer>>;
+
+        template <bool is_const>
+        class base_iterator {
+            using owner_type = std::conditional_t<is_const, const stable_vector, stable_vector>;
+
+        public:
+            using pointer_type = std::conditional_t<is_const, const_pointer, pointer>;
+            using reference_type = std::conditional_t<is_const, const_reference, reference>;
+            using difference_type = std::ptrdiff_t;
+            using value_type = T;
+            using iterator_category = std::random_access_iterator_tag;
+
+            owner_type* owner_ = nullptr;
+            size_type index_ = 0;
+
+            /***************************/
+            base_iterator() noexcept = default;
+
+            base_iterator(owner_type* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+
+            // iterator -> const_iterator
+            template <bool other_const> requires (is_const && !other_const)
+            base_iterator(const base_iterator<other_const>& other) noexcept : owner_(other.owner_), index_(other.index_) {}
+            /***************************/
+
+
+            /***************************/
+            reference_type operator*() const {
+                return (*owner_)[index_];
+            }
+
+            pointer_type operator->() const {
+                return std::addressof((*owner_)[index_]);
+            }
+
+            reference_type operator[](const difference_type offset) const {
+                return (*owner_)[index_ + offset];
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator& operator++() {
+                ++index_;
+                return *this;
+            }
+
+            base_iterator& operator--() {
+                --index_;
+                return *this;
+            }
+
+            base_iterator operator++(int) {
+                base_iterator temp = *this;
+                ++index_;
+                return temp;
+            }
+
+            base_iterator operator--(int) {
+                base_iterator temp = *this;
+                --index_;
+                return temp;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            base_iterator operator+(const difference_type value) const {
+                return base_iterator(owner_, index_ + value);
+            }
+
+            friend base_iterator operator+(const difference_type value, const base_iterator& it) {
+                return it + value;
+            }
+
+            base_iterator operator-(const difference_type value) const {
+                return base_iterator(owner_, index_ - value);
+            }
+
+            difference_type operator-(const base_iterator& other) const {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            base_iterator& operator+=(const difference_type value) {
+                index_ += value;
+                return *this;
+            }
+
+            base_iterator& operator-=(const difference_type value) {
+                index_ -= value;
+                return *this;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            bool operator==(const base_iterator& other) const {
+                return index_ == other.index_;
+            }
+
+            auto operator<=>(const base_iterator& other) const {
+                return index_ <=> other.index_;
+            }
+            /***************************/
+        };
+
+    public:
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    public:
+        stable_vector() noexcept = default;
+
+        explicit stable_vector(const allocator_type& alloc) noexcept : chunks_(typename chunk_table::allocator_type(alloc)), allocator_(alloc) {}
+
+        explicit stable_vector(const size_type n, const allocator_type& alloc = allocator_type()) : stable_vector(alloc) {
+            resize(n);
+        }
+
+        stable_vector(const size_type n, const_reference value, const allocator_type& alloc = allocator_type()) : stable_vector(alloc) {
+            resize(n, value);
+        }
+
+        stable_vector(const std::initializer_list<value_type> list, const allocator_type& alloc = allocator_type()) : stable_vector(alloc) {
+            reserve(list.size());
+            for (const auto& value : list) {
+                push_back(value);
+            }
+        }
+
+        stable_vector(const stable_vector& other) : stable_vector(allocator_traits::select_on_container_copy_construction(other.allocator_)) {
+            reserve(other.size_);
+            for (size_type index = 0; index < other.size_; ++index) {
+                push_back(other[index]);
+            }
+        }
+
+        stable_vector(stable_vector&& other) noexcept
+            : chunks_(std::move(other.chunks_)), size_(std::exchange(other.size_, 0)), allocator_(std::move(other.allocator_)) {}
+
+        stable_vector& operator=(const stable_vector& other) {
+            if (this != &other) {
+                if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+                    // Блоки выделены старым аллокатором - вернуть их ему, пока он ещё наш
+                    if (allocator_ != other.allocator_) {
+                        clear();
+                        release_chunks_(0);
+
+                        const chunk_table empty(typename chunk_table::allocator_type(other.allocator_));
+                        chunks_ = empty;
+                    }
+
+                    allocator_ = other.allocator_;
+                }
+
+                assign_(other.size_, [&other](const size_type index) -> const_reference { return other[index]; });
+            }
+
+            return *this;
+        }
+
+        stable_vector& operator=(stable_vector&& other) noexcept(allocator_traits::propagate_on_container_move_assignment::value
+                                                                 || allocator_traits::is_always_equal::value) {
+            if (this != &other) {
+                if constexpr (!allocator_traits::propagate_on_container_move_assignment::value && !allocator_traits::is_always_equal::value) {
+                    // Аллокатор остаётся свой, и если он не равен чужому - перемещаем поэлементно
+                    if (allocator_ != other.allocator_) {
+                        assign_(other.size_, [&other](const size_type index) -> value_type&& { return std::move(other[index]); });
+                        other.clear();
+                        return *this;
+                    }
+                }
+
+                clear();
+                release_chunks_(0);
+
+                if constexpr (allocator_traits::propagate_on_container_move_assignment::value) {
+                    allocator_ = std::move(other.allocator_);
+                }
+
+                chunks_ = std::move(other.chunks_);
+                size_ = std::exchange(other.size_, 0);
+            }
+
+            return *this;
+        }
+
+        ~stable_vector() {
+            clear();
+            release_chunks_(0);
+        }
+
+        void swap(stable_vector& other) noexcept {
+            using std::swap;
+            if constexpr (allocator_traits::propagate_on_container_swap::value) {
+                swap(allocator_, other.allocator_);
+            }
+
+            chunks_.swap(other.chunks_);
+            swap(size_, other.size_);
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_;
+        }
+
+        // Выделяет недостающие блоки; уже существующие элементы не трогаются
+        void reserve(const size_type new_capacity) {
+            const size_type needed = (new_capacity + chunk_mask_) >> chunk_shift_;
+            if (needed <= chunks_.size()) {
+                return;
+            }
+
+            chunks_.reserve(needed);
+            while (chunks_.size() < needed) {
+                chunks_.push_back(allocator_traits::allocate(allocator_, chunk_size));
+            }
+        }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        void push_back(value_type&& value) {
+            emplace_back(std::move(value));
+        }
+
+        template <typename... Args>
+        reference emplace_back(Args&&... args) {
+            // Элементы не переезжают, поэтому аргумент-ссылка на элемент остаётся валидной и после reserve
+            if (size_ == capacity()) {
+                reserve(size_ + 1);
+            }
+
+            pointer slot = slot_(size_);
+            allocator_traits::construct(allocator_, slot, std::forward<Args>(args)...);
+            ++size_;
+            return *slot;
+        }
+
+        void pop_back() {
+            allocator_traits::destroy(allocator_, slot_(--size_));
+        }
+
+        void resize(const size_type count) {
+            resize_(count, [this](pointer slot) { allocator_traits::construct(allocator_, slot); });
+        }
+
+        void resize(const size_type count, const_reference value) {
+            resize_(count, [this, &value](pointer slot) { allocator_traits::construct(allocator_, slot, value); });
+        }
+
+        void clear() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                while (size_ != 0) {
+                    allocator_traits::destroy(allocator_, slot_(--size_));
+                }
+            }
+            size_ = 0;
+        }
+
+        // Возвращает аллокатору блоки целиком, элементы по-прежнему не перемещаются
+        void shrink_to_fit() {
+            release_chunks_((size_ + chunk_mask_) >> chunk_shift_);
+            chunks_.shrink_to_fit();
+        }
+
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+        [[nodiscard]] size_type capacity() const noexcept { return chunks_.size() << chunk_shift_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        [[nodiscard]] size_type max_size() const noexcept {
+            return std::min<size_type>(allocator_traits::max_size(allocator_), std::numeric_limits<difference_type>::max());
+        }
+
+        reference operator[](const size_type index) noexcept { return *slot_(index); }
+        const_reference operator[](const size_type index) const noexcept { return *slot_(index); }
+
+        reference at(const size_type index) {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return *slot_(index);
+        }
+
+        const_reference at(const size_type index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return *slot_(index);
+        }
+
+        reference front() { return *slot_(0); }
+        const_reference front() const { return *slot_(0); }
+
+        reference back() { return *slot_(size_ - 1); }
+        const_reference back() const { return *slot_(size_ - 1); }
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator cbegin() const noexcept { return begin(); }
+
+        iterator end() noexcept { return iterator(this, size_); }
+        const_iterator end() const noexcept { return const_iterator(this, size_); }
+        const_iterator cend() const noexcept { return end(); }
+
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+
+    private:
+        pointer slot_(const size_type index) const noexcept {
+            return chunks_[index >> chunk_shift_] + (index & chunk_mask_);
+        }
+
+        template <typename Construct>
+        void resize_(const size_type count, Construct construct) {
+            if (count < size_) {
+                while (size_ != count) {
+                    allocator_traits::destroy(allocator_, slot_(--size_));
+                }
+                return;
+            }
+
+            reserve(count);
+            while (size_ != count) {
+                construct(slot_(size_));
+                ++size_;
+            }
+        }
+
+        // Поэлементное присваивание: живые элементы присваиваются, недостающие конструируются в
+        // своих же блоках, лишние разрушаются
+        template <typename Get>
+        void assign_(const size_type count, Get get) {
+            while (size_ > count) {
+                allocator_traits::destroy(allocator_, slot_(--size_));
+            }
+
+            for (size_type index = 0; index < size_; ++index) {
+                *slot_(index) = get(index);
+            }
+
+            reserve(count);
+            while (size_ != count) {
+                allocator_traits::construct(allocator_, slot_(size_), get(size_));
+                ++size_;
+            }
+        }
+
+        void release_chunks_(const size_type keep) noexcept {
+            while (chunks_.size() > keep) {
+                allocator_traits::deallocate(allocator_, chunks_.back(), chunk_size);
+                chunks_.pop_back();
+            }
+        }
+
+        chunk_table chunks_;
+        size_type size_ = 0;
+        [[no_unique_address]] allocator_type allocator_;
+    };
+
+    template <typename T, typename Allocator, std::size_t ChunkSize>
+    bool operator==(const stable_vector<T, Allocator, ChunkSize>& lhs, const stable_vector<T, Allocator, ChunkSize>& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        for (std::size_t index = 0; index < lhs.size(); ++index) {
+            if (!(lhs[index] == rhs[index])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename T, typename Allocator, std::size_t ChunkSize>
+    void swap(stable_vector<T, Allocator, ChunkSize>& lhs, stable_vector<T, Allocator, ChunkSize>& rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include "../concurrent_vector/concurrent_vector.hpp"
+
+namespace {
+    using pmr_string_allocator = std::pmr::polymorphic_allocator<std::string>;
+
+    std::string long_string(const int i) {
+        // Длиннее SSO-буфера: строка сама выделяет память
+        return std::string(40, static_cast<char>('a' + i % 26));
+    }
+
+    // Пропускает конструктор дальше только когда его откроют: так задаётся порядок потоков
+    struct gate {
+        std::atomic<bool> entered = false;
+        std::atomic<bool> open = false;
+    };
+
+    // Отрицательное значение - конструктор бросает. Конструктора по умолчанию нет
+    struct throwing {
+        static inline std::atomic<int> live = 0;
+
+        int value = 0;
+
+        explicit throwing(const int v, gate* g = nullptr) : value(v) {
+            if (g != nullptr) {
+                g->entered = true;
+                while (!g->open) {
+                    std::this_thread::yield();
+                }
+            }
+            if (v < 0) {
+                throw std::runtime_error("throwing");
+            }
+            ++live;
+        }
+
+        throwing(const throwing& other) : value(other.value) { ++live; }
+        ~throwing() { --live; }
+    };
+}
+
+/***************************/
+NP_TEST(concurrent_vector_parallel_push_back) {
+    np::concurrent_vector<int> v;
+    constexpr int threads = 8;
+    constexpr int per_thread = 10000;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&v, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                v.push_back(t * per_thread + i);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    NP_CHECK(v.size() == threads * per_thread);
+
+    std::vector<int> seen(v.begin(), v.end());
+    std::sort(seen.begin(), seen.end());
+    for (int i = 0; i < threads * per_thread; ++i) {
+        NP_CHECK(seen[i] == i);
+    }
+}
+
+NP_TEST(concurrent_vector_elements_do_not_move) {
+    np::concurrent_vector<std::string> v;
+    const std::string* first = &*v.push_back("first");
+    for (int i = 0; i < 10000; ++i) {
+        v.push_back(long_string(i));
+    }
+
+    NP_CHECK(first == &v[0] && *first == "first");
+}
+
+NP_TEST(concurrent_vector_assignment_honors_allocator_propagation) {
+    np::test::check_pmr_assignment<np::concurrent_vector<std::string, pmr_string_allocator>>();
+
+    np::concurrent_vector<int> a{1, 2, 3};
+    np::concurrent_vector<int> b{4, 5, 6, 7, 8};
+    a = b;
+    NP_CHECK(a.size() == 5 && a[4] == 8);
+    a = std::move(b);
+    NP_CHECK(a.size() == 5 && b.empty());
+}
+
+NP_TEST(concurrent_vector_bad_alloc_does_not_count_the_slot) {
+    np::test::tracking_resource resource;
+
+    {
+        np::concurrent_vector<std::string, pmr_string_allocator> v{pmr_string_allocator(&resource)};
+        v.reserve(1);
+        resource.set_limit(0);
+
+        // Первая корзина уже есть, вторую выделить нельзя
+        for (int i = 0; i < 32; ++i) {
+            v.push_back("short");
+        }
+        NP_CHECK_THROWS(v.push_back("short"), std::bad_alloc);
+        NP_CHECK(v.size() == 32);
+
+        resource.set_limit(static_cast<std::size_t>(-1));
+        v.push_back("after");
+        NP_CHECK(v.size() == 33 && v[32] == "after");
+    }
+
+    NP_CHECK(resource.live_blocks() == 0 && resource.foreign_frees() == 0);
+}
+
+NP_TEST(concurrent_vector_readers_see_only_built_elements) {
+    np::concurrent_vector<std::string> v;
+    std::atomic<int> writing = 4;
+    std::atomic<bool> torn = false;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&v, &writing] {
+            for (int i = 0; i < 5000; ++i) {
+                v.push_back(long_string(i));
+            }
+            --writing;
+        });
+    }
+    threads.emplace_back([&v, &writing, &torn] {
+        while (writing != 0) {
+            for (const std::string& item : v) {
+                torn = torn || item.size() != 40;
+            }
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    NP_CHECK(!torn && v.size() == 4 * 5000);
+}
+
+NP_TEST(concurrent_vector_throwing_constructor_leaves_no_element) {
+    {
+        np::concurrent_vector<throwing> v;
+        v.emplace_back(1);
+        NP_CHECK_THROWS(v.emplace_back(-1), std::runtime_error);
+        NP_CHECK(v.size() == 1 && throwing::live == 1);
+
+        v.emplace_back(2);
+        NP_CHECK(v.size() == 2 && v[1].value == 2);
+    }
+
+    NP_CHECK(throwing::live == 0);
+}
+
+NP_TEST(concurrent_vector_end_stops_before_unconstructed_slot) {
+    {
+        np::concurrent_vector<throwing> v;
+        v.emplace_back(0);
+
+        gate g;
+        std::thread slow([&v, &g] {
+            try {
+                v.emplace_back(-1, &g);
+            } catch (const std::runtime_error&) {
+            }
+        });
+        while (!g.entered) {
+            std::this_thread::yield();
+        }
+
+        // Место 1 ещё строится: место 2 готово раньше, но обход на него не выходит
+        v.emplace_back(2);
+        NP_CHECK(v.size() == 1 && std::distance(v.begin(), v.end()) == 1);
+
+        // Конструктор места 1 бросил: дыра ждёт следующего push_back, публикация стоит
+        g.open = true;
+        slow.join();
+        NP_CHECK(v.size() == 1);
+
+        v.emplace_back(1);
+        NP_CHECK(v.size() == 3 && v[1].value == 1 && v[2].value == 2);
+    }
+
+    NP_CHECK(throwing::live == 0);
+}
+/***************************/
@@ -0,0 +1,42 @@
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include "../cow_vector/cow_vector.hpp"
+
+/***************************/
+NP_TEST(cow_vector_copies_on_first_write) {
+    np::cow_vector<int> a{1, 2, 3};
+    np::cow_vector<int> b = a;
+    NP_CHECK(a.shares_buffer_with(b) && a.use_count() == 2);
+
+    b.push_back(4);
+    NP_CHECK(!a.shares_buffer_with(b));
+    NP_CHECK(a.size() == 3 && b.size() == 4 && b[3] == 4);
+
+    b.set(0, 10);
+    NP_CHECK(b[0] == 10 && a[0] == 1);
+}
+
+NP_TEST(atomic_cow_vector_publishes_snapshots) {
+    np::atomic_cow_vector<int> shared(np::cow_vector<int>{0});
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&shared] {
+            for (int i = 0; i < 250; ++i) {
+                shared.update([](np::cow_vector<int>& next) { next.push_back(1); });
+            }
+        });
+    }
+
+    const np::cow_vector<int> snapshot = shared.load();
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    NP_CHECK(shared.load().size() == 1001);
+    NP_CHECK(snapshot.size() <= 1001 && snapshot[0] == 0);
+}
+/***************************/
@@ -0,0 +1,9 @@
+// Собирается отдельно от np_tests, без NP_CHECKED_ITERATORS и без NDEBUG: проверки итераторов
+// включаются только явно, и итератор по умолчанию остаётся размером с указатель
+#undef NDEBUG
+
+#include "../vector/vector.hpp"
+
+static_assert(NP_CHECKED_ITERATORS == 0);
+static_assert(sizeof(np::vector<int>::iterator) == sizeof(int*));
+static_assert(sizeof(np::vector<int>::const_iterator) == sizeof(const int*));
@@ -0,0 +1,40 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "test.hpp"
+
+#include "../flat_map/flat_map.hpp"
+#include "../flat_map/flat_set.hpp"
+
+/***************************/
+NP_TEST(flat_map_lookup_and_update) {
+    np::flat_map<int, std::string> map{{3, "c"}, {1, "a"}, {2, "b"}, {1, "dup"}};
+    NP_CHECK(map.size() == 3);
+    NP_CHECK(map.at(1) == "a" && map.contains(2) && !map.contains(4));
+
+    const auto keys = map.keys();
+    NP_CHECK(std::is_sorted(keys.begin(), keys.end()));
+
+    map[4] = "d";
+    NP_CHECK(map.size() == 4 && map.find(4) != map.end());
+
+    const auto [it, inserted] = map.try_emplace(2, "ignored");
+    NP_CHECK(!inserted && (*it).second == "b");
+
+    NP_CHECK(map.erase(3) == 1 && !map.contains(3));
+    NP_CHECK_THROWS(map.at(3), std::out_of_range);
+
+    np::flat_map<int, int> sorted(np::sorted_unique, np::vector<int>{1, 2, 5}, np::vector<int>{10, 20, 50});
+    NP_CHECK(sorted.at(5) == 50 && sorted.lower_bound(3) == sorted.find(5));
+}
+
+NP_TEST(flat_set_keeps_unique_sorted_keys) {
+    np::flat_set<int> set{5, 1, 3, 1, 5};
+    NP_CHECK(set.size() == 3 && std::is_sorted(set.begin(), set.end()));
+
+    NP_CHECK(set.insert(2).second && !set.insert(3).second);
+    NP_CHECK(set.count(2) == 1 && set.contains(5));
+    NP_CHECK(set.erase(1) == 1 && set.size() == 3);
+}
+/***************************/
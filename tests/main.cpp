@@ -0,0 +1,34 @@
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+#include "test.hpp"
+
+// np_tests [подстрока] - прогоняет все тесты или только те, чьё имя содержит подстроку
+
+int main(const int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    int passed = 0;
+    int failed = 0;
+
+    for (const auto& test : np::test::registry()) {
+        if (filter != nullptr && std::strstr(test.name, filter) == nullptr) {
+            continue;
+        }
+
+        try {
+            test.fn();
+            ++passed;
+        } catch (const std::exception& error) {
+            std::cerr << "FAILED " << test.name << ": " << error.what() << '\n';
+            ++failed;
+        } catch (...) {
+            std::cerr << "FAILED " << test.name << ": unknown exception\n";
+            ++failed;
+        }
+    }
+
+    std::cout << passed << " passed, " << failed << " failed\n";
+    return failed == 0 ? 0 : 1;
+}
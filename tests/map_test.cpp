@@ -0,0 +1,44 @@
+#include <string>
+
+#include "test.hpp"
+
+#include "../map_/map.hpp"
+
+/***************************/
+NP_TEST(map_erase_relinks_the_tree) {
+    Map<int, std::string> map;
+    // Корень с двумя детьми, у детей - свои поддеревья
+    for (const int key : {50, 30, 70, 20, 40, 60, 80, 65}) {
+        map.insert({key, std::to_string(key)});
+    }
+
+    // Лист, узел с одним ребёнком, узел с двумя детьми и корень
+    NP_CHECK(map.erase(20) == 1 && map.erase(20) == 0);
+    NP_CHECK(map.erase(map.find(60))->first == 65);
+    NP_CHECK(map.erase(map.find(30))->first == 40);
+    NP_CHECK(map.erase(map.find(50))->first == 65);
+    NP_CHECK(map.erase(map.find(80)).current == nullptr);
+
+    NP_CHECK(map.size() == 3);
+    for (const int key : {40, 65, 70}) {
+        NP_CHECK(map.count(key) == 1 && map.at(key) == std::to_string(key));
+    }
+    for (const int key : {20, 30, 50, 60, 80}) {
+        NP_CHECK(map.count(key) == 0);
+    }
+}
+
+NP_TEST(map_erase_everything_and_reuse) {
+    Map<std::string, int> map;
+    map.insert({"Apple", 200});
+    NP_CHECK(map.erase(map.find("Apple")).current == nullptr && map.empty());
+    NP_CHECK(map.find("Apple").current == nullptr);
+    NP_CHECK(map.erase(map.find("Apple")).current == nullptr);
+
+    // Заголовок пережил удаление последнего узла
+    NP_CHECK(map.insert({"Pear", 1}).second && map.at("Pear") == 1);
+
+    const Map<std::string, int>::const_iterator pear = map.find("Pear");
+    NP_CHECK(map.erase(pear, Map<std::string, int>::const_iterator()).current == nullptr && map.empty());
+}
+/***************************/
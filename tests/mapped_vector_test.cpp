@@ -0,0 +1,35 @@
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+#include "test.hpp"
+
+#include "../mapped_vector/mapped_vector.hpp"
+
+namespace {
+    std::string temp_path(const char* name) {
+        return (std::filesystem::temp_directory_path() / (std::string(name) + "." + std::to_string(::getpid()))).string();
+    }
+}
+
+/***************************/
+NP_TEST(mapped_vector_persists_through_reopen) {
+    const std::string path = temp_path("np_tests_mapped_vector");
+
+    {
+        np::mapped_vector<std::uint64_t> v(path, np::open_mode::create);
+        for (std::uint64_t i = 0; i < 10000; ++i) {
+            v.push_back(i * i);
+        }
+        v.flush();
+    }
+
+    {
+        const np::mapped_vector<std::uint64_t> v(path, np::open_mode::read_only);
+        NP_CHECK(v.size() == 10000 && v[9999] == 9999ull * 9999ull);
+    }
+
+    std::filesystem::remove(path);
+}
+/***************************/
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "test.hpp"
+
+#include "../packed_vector/delta_vector.hpp"
+#include "../packed_vector/packed_vector.hpp"
+
+/***************************/
+NP_TEST(packed_vector_round_trip) {
+    np::packed_vector<23> v;
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        v.push_back((i * 7919) & v.max_value);
+    }
+
+    NP_CHECK(v.size() == 1000 && v.bytes() < 1000 * sizeof(std::uint64_t));
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        NP_CHECK(v[i] == ((i * 7919) & v.max_value));
+    }
+
+    v.set(10, v.max_value);
+    NP_CHECK(v[10] == v.max_value && v[9] == (9 * 7919 & v.max_value) && v[11] == (11 * 7919 & v.max_value));
+    NP_CHECK_THROWS(v.set(0, v.max_value + 1), std::out_of_range);
+
+    std::uint64_t out[100];
+    v.unpack(500, 100, out);
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        NP_CHECK(out[i] == v[500 + i]);
+    }
+}
+
+NP_TEST(delta_vector_round_trip) {
+    np::delta_vector<> v;
+    std::uint64_t value = 1000000;
+    np::vector<std::uint64_t> expected;
+    for (int i = 0; i < 1000; ++i) {
+        value += static_cast<std::uint64_t>(i % 5);
+        v.push_back(value);
+        expected.push_back(value);
+    }
+
+    NP_CHECK(v.size() == 1000 && v.bytes() < 1000 * sizeof(std::uint64_t) / 4);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        NP_CHECK(v[i] == expected[i]);
+    }
+
+    np::vector<std::uint64_t> decoded(300);
+    v.decode(100, 300, decoded.data());
+    NP_CHECK(std::equal(decoded.begin(), decoded.end(), expected.begin() + 100));
+
+    v.pop_back();
+    NP_CHECK(v.size() == 999 && v[998] == expected[998]);
+}
+
+NP_TEST(packed_vectors_move_without_allocating) {
+    static_assert(std::is_nothrow_default_constructible_v<np::packed_vector<23>>);
+    static_assert(std::is_nothrow_move_constructible_v<np::packed_vector<23>>);
+    static_assert(std::is_nothrow_move_assignable_v<np::packed_vector<23>>);
+    static_assert(std::is_nothrow_move_constructible_v<np::delta_vector<>>);
+    static_assert(std::is_nothrow_move_assignable_v<np::delta_vector<>>);
+
+    np::packed_vector<23> packed{1, 2, 3};
+    np::packed_vector<23> packed_target = std::move(packed);
+    NP_CHECK(packed.empty() && packed.bytes() == 0 && packed == np::packed_vector<23>());
+    NP_CHECK(packed_target.size() == 3 && packed_target[2] == 3);
+
+    // Перемещённый снова заводит заполнитель при первой записи
+    packed.push_back(7);
+    packed.resize(70, 5);
+    NP_CHECK(packed.size() == 70 && packed[0] == 7 && packed[69] == 5);
+    packed_target = std::move(packed);
+    NP_CHECK(packed.empty() && packed_target.size() == 70);
+    packed.resize(0);
+    NP_CHECK(packed.bytes() == 0 && packed.capacity() == 0);
+
+    np::delta_vector<> delta;
+    for (std::uint64_t i = 0; i < 300; ++i) {
+        delta.push_back(i * 3);
+    }
+    np::delta_vector<> delta_target = std::move(delta);
+    NP_CHECK(delta.empty() && delta.bytes() == 0 && delta_target.size() == 300 && delta_target[299] == 897);
+
+    for (std::uint64_t i = 0; i < 200; ++i) {
+        delta.push_back(i);
+    }
+    NP_CHECK(delta.size() == 200 && delta[0] == 0 && delta[199] == 199);
+    delta_target = std::move(delta);
+    NP_CHECK(delta.empty() && delta_target.size() == 200 && delta_target[127] == 127);
+}
+/***************************/
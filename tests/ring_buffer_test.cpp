@@ -0,0 +1,51 @@
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+#include "test.hpp"
+
+#include "../ring_buffer/ring_buffer.hpp"
+
+/***************************/
+NP_TEST(ring_buffer_modes) {
+    np::ring_buffer<int> grow;
+    for (int i = 0; i < 10; ++i) {
+        grow.push_back(i);
+        grow.push_front(-i);
+    }
+    NP_CHECK(grow.size() == 20 && grow.front() == -9 && grow.back() == 9 && grow.capacity() == 32);
+
+    np::ring_buffer<int> fixed(np::ring_mode::fixed, 4);
+    for (int i = 0; i < 4; ++i) {
+        fixed.push_back(i);
+    }
+    NP_CHECK_THROWS(fixed.push_back(4), std::length_error);
+    NP_CHECK(fixed.size() == 4 && fixed.back() == 3);
+
+    np::ring_buffer<int> window(np::ring_mode::overwrite, 4);
+    for (int i = 0; i < 10; ++i) {
+        window.push_back(i);
+    }
+    NP_CHECK(window.size() == 4 && window.front() == 6 && window.back() == 9);
+
+    const auto [first, second] = window.spans();
+    NP_CHECK(first.size() + second.size() == 4);
+
+    window.linearize();
+    NP_CHECK(window.second_span().empty() && window.first_span()[0] == 6);
+
+    window.pop_front(2);
+    NP_CHECK(window.size() == 2 && window.front() == 8);
+}
+
+NP_TEST(ring_buffer_assignment_honors_allocator_propagation) {
+    np::test::check_pmr_assignment<np::ring_buffer<std::string, std::pmr::polymorphic_allocator<std::string>>>();
+
+    np::ring_buffer<int> a(np::ring_mode::overwrite, 4);
+    np::ring_buffer<int> b{1, 2, 3, 4, 5};
+    a = b;
+    NP_CHECK(a == b && a.mode() == np::ring_mode::growable);
+    a = std::move(b);
+    NP_CHECK(a.size() == 5 && b.empty());
+}
+/***************************/
@@ -0,0 +1,36 @@
+#include <cstdint>
+#include <span>
+#include <string>
+#include <tuple>
+
+#include "test.hpp"
+
+#include "../soa_vector/soa_vector.hpp"
+
+/***************************/
+NP_TEST(soa_vector_stores_columns_separately) {
+    np::soa_vector<int, double, std::string> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i, i * 0.5, std::to_string(i));
+    }
+
+    NP_CHECK(v.size() == 100);
+    NP_CHECK(std::get<0>(v[42]) == 42 && std::get<1>(v[42]) == 21.0 && std::get<2>(v[42]) == "42");
+
+    const std::span<double> halves = v.column<1>();
+    NP_CHECK(halves.size() == 100 && halves[10] == 5.0);
+    NP_CHECK(reinterpret_cast<std::uintptr_t>(halves.data()) % 64 == 0);
+
+    std::get<0>(v[0]) = -1;
+    NP_CHECK(v.column<0>()[0] == -1);
+
+    v.pop_back();
+    NP_CHECK(v.size() == 99 && v.column<2>().size() == 99);
+
+    int sum = 0;
+    for (const auto& row : v) {
+        sum += std::get<0>(row);
+    }
+    NP_CHECK(sum == 98 * 99 / 2 - 1);
+}
+/***************************/
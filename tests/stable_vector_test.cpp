@@ -0,0 +1,45 @@
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+#include "test.hpp"
+
+#include "../stable_vector/stable_vector.hpp"
+
+namespace {
+    std::string long_string(const int i) {
+        // Длиннее SSO-буфера: строка сама выделяет память
+        return std::string(40, static_cast<char>('a' + i % 26));
+    }
+}
+
+/***************************/
+NP_TEST(stable_vector_keeps_references_valid) {
+    np::stable_vector<std::string, std::allocator<std::string>, 4> v;
+    v.push_back("first");
+    const std::string* first = &v[0];
+
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(long_string(i));
+    }
+    NP_CHECK(first == &v[0] && v.size() == 1001 && v.capacity() % 4 == 0);
+
+    v.resize(10);
+    v.shrink_to_fit();
+    NP_CHECK(v.size() == 10 && v.capacity() == 12 && first == &v[0]);
+
+    np::stable_vector<std::string, std::allocator<std::string>, 4> copy = v;
+    NP_CHECK(copy == v);
+}
+
+NP_TEST(stable_vector_assignment_honors_allocator_propagation) {
+    np::test::check_pmr_assignment<np::stable_vector<std::string, std::pmr::polymorphic_allocator<std::string>, 4>>();
+
+    np::stable_vector<int> a{1, 2, 3};
+    np::stable_vector<int> b{4, 5, 6, 7, 8};
+    a = b;
+    NP_CHECK(a == b);
+    a = std::move(b);
+    NP_CHECK(a.size() == 5 && b.empty());
+}
+/***************************/
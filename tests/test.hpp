@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Минимальный набор для модульных тестов без внешних зависимостей: NP_TEST регистрирует функцию,
+// NP_CHECK / NP_CHECK_THROWS проверяют условие и при провале бросают test_failure с местом проверки.
+// Проверки не завязаны на assert, поэтому работают и в Release-сборке.
+
+namespace np::test {
+    struct test_failure : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    struct test_case {
+        const char* name;
+        void (*fn)();
+    };
+
+    inline std::vector<test_case>& registry() {
+        static std::vector<test_case> tests;
+        return tests;
+    }
+
+    struct registrar {
+        registrar(const char* name, void (*fn)()) {
+            registry().push_back({name, fn});
+        }
+    };
+
+    [[noreturn]] inline void fail(const char* expr, const char* file, const int line) {
+        throw test_failure(std::string(file) + ":" + std::to_string(line) + ": " + expr);
+    }
+
+    // Ресурс, который помнит свои блоки и ловит освобождение чужих: так ошибка "освободили
+    // через другой аллокатор" видна и без санитайзера
+    class tracking_resource : public std::pmr::memory_resource {
+    public:
+        ~tracking_resource() override {
+            if (!blocks_.empty()) {
+                std::cerr << "tracking_resource: " << blocks_.size() << " blocks leaked\n";
+            }
+        }
+
+        [[nodiscard]] std::size_t live_blocks() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return blocks_.size();
+        }
+
+        [[nodiscard]] std::size_t foreign_frees() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return foreign_frees_;
+        }
+
+        // Следующие limit байт выделяются, дальше - std::bad_alloc
+        void set_limit(const std::size_t limit) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            limit_ = limit;
+        }
+
+    private:
+        void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (bytes > limit_) {
+                throw std::bad_alloc();
+            }
+
+            limit_ -= bytes;
+            void* ptr = ::operator new(bytes, std::align_val_t(alignment));
+            blocks_.insert(ptr);
+            return ptr;
+        }
+
+        void do_deallocate(void* ptr, const std::size_t, const std::size_t alignment) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (blocks_.erase(ptr) == 0) {
+                // Чужой блок не трогаем: освобождать его должен владелец
+                ++foreign_frees_;
+                return;
+            }
+
+            ::operator delete(ptr, std::align_val_t(alignment));
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        mutable std::mutex mutex_;
+        std::set<void*> blocks_;
+        std::size_t foreign_frees_ = 0;
+        std::size_t limit_ = static_cast<std::size_t>(-1);
+    };
+}
+
+#define NP_TEST_CONCAT_(a, b) a##b
+#define NP_TEST_CONCAT(a, b) NP_TEST_CONCAT_(a, b)
+
+#define NP_TEST(name)                                                                                   \
+    static void name();                                                                                 \
+    static const ::np::test::registrar NP_TEST_CONCAT(name, _registrar_)(#name, &name);                 \
+    static void name()
+
+#define NP_CHECK(expr)                                                                                  \
+    do {                                                                                                \
+        if (!(expr)) {                                                                                  \
+            ::np::test::fail(#expr, __FILE__, __LINE__);                                                \
+        }                                                                                               \
+    } while (false)
+
+#define NP_CHECK_THROWS(expr, exception)                                                                \
+    do {                                                                                                \
+        bool thrown_ = false;                                                                           \
+        try {                                                                                           \
+            (void)(expr);                                                                               \
+        } catch (const exception&) {                                                                    \
+            thrown_ = true;                                                                             \
+        }                                                                                               \
+        if (!thrown_) {                                                                                 \
+            ::np::test::fail(#expr " does not throw " #exception, __FILE__, __LINE__);                  \
+        }                                                                                               \
+    } while (false)
+
+namespace np::test {
+    // Копирование и перемещение между контейнерами строк на разных pmr-ресурсах: блоки остаются
+    // у своего ресурса, ни один не освобождается через чужой
+    template <typename Container>
+    void check_pmr_assignment() {
+        using allocator_type = typename Container::allocator_type;
+
+        // Длиннее SSO-буфера: строка сама выделяет память из ресурса контейнера
+        const auto long_string = [](const int i) { return std::string(40, static_cast<char>('a' + i % 26)); };
+
+        tracking_resource first;
+        tracking_resource second;
+
+        {
+            Container a{allocator_type(&first)};
+            Container b{allocator_type(&second)};
+            for (int i = 0; i < 50; ++i) {
+                b.push_back(long_string(i));
+            }
+            a.push_back("x");
+
+            a = b;
+            NP_CHECK(a.size() == 50 && a[49] == b[49]);
+            NP_CHECK(a.get_allocator().resource() == &first);
+
+            Container c{allocator_type(&first)};
+            c = std::move(b);
+            NP_CHECK(c.size() == 50 && c[0] == long_string(0) && b.empty());
+
+            Container d{allocator_type(&first)};
+            d = std::move(c);
+            NP_CHECK(d.size() == 50 && d[49] == a[49]);
+
+            a = a;
+            NP_CHECK(a.size() == 50);
+        }
+
+        NP_CHECK(first.foreign_frees() == 0 && second.foreign_frees() == 0);
+        NP_CHECK(first.live_blocks() == 0 && second.live_blocks() == 0);
+    }
+}
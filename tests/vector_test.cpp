@@ -0,0 +1,632 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <unistd.h>
+
+#include "test.hpp"
+
+#include "../vector/aligned_allocator.hpp"
+#include "../vector/default_init_allocator.hpp"
+#include "../vector/malloc_allocator.hpp"
+#include "../vector/mmap_allocator.hpp"
+#include "../vector/rank_select.hpp"
+#include "../vector/serialization.hpp"
+#include "../vector/vector.hpp"
+
+namespace {
+    // Хранит указатель на себя: побайтовый перенос без конструктора перемещения его ломает
+    struct self_ref {
+        int value = 0;
+        const self_ref* self = this;
+
+        self_ref(const int v = 0) noexcept : value(v) {}
+        self_ref(const self_ref& other) noexcept : value(other.value) {}
+        self_ref& operator=(const self_ref& other) noexcept {
+            value = other.value;
+            return *this;
+        }
+
+        [[nodiscard]] bool intact() const noexcept { return self == this; }
+        bool operator==(const self_ref& other) const noexcept { return value == other.value; }
+    };
+
+    static_assert(!np::is_trivially_relocatable_v<self_ref>);
+    static_assert(np::is_trivially_relocatable_v<std::unique_ptr<int>>);
+
+    template <typename Vector>
+    bool all_intact(const Vector& v) {
+        return std::all_of(v.data(), v.data() + v.size(), [](const self_ref& item) { return item.intact(); });
+    }
+
+    template <typename Vector, typename T>
+    bool holds(const Vector& v, const std::initializer_list<T> expected) {
+        return std::equal(v.data(), v.data() + v.size(), expected.begin(), expected.end());
+    }
+
+    // Однопроходный диапазон известного размера: istream_iterator, ограниченный counted_iterator
+    struct single_pass_sized : std::ranges::view_base {
+        std::istringstream* in = nullptr;
+        std::size_t n = 0;
+
+        auto begin() const { return std::counted_iterator(std::istream_iterator<std::string>(*in), static_cast<std::ptrdiff_t>(n)); }
+        auto end() const { return std::default_sentinel; }
+        std::size_t size() const { return n; }
+    };
+
+    static_assert(std::ranges::sized_range<single_pass_sized> && !std::ranges::forward_range<single_pass_sized>);
+
+    // Итератор только для перемещения: его нельзя скопировать, чтобы пройти диапазон второй раз
+    struct move_only_counter {
+        using difference_type = std::ptrdiff_t;
+        using value_type = int;
+
+        int i = 0;
+        int last = 0;
+
+        move_only_counter(const int first, const int end) : i(first), last(end) {}
+        move_only_counter(move_only_counter&&) = default;
+        move_only_counter& operator=(move_only_counter&&) = default;
+
+        int operator*() const { return i; }
+        move_only_counter& operator++() { ++i; return *this; }
+        void operator++(int) { ++i; }
+        bool operator==(std::default_sentinel_t) const { return i == last; }
+    };
+
+    static_assert(std::input_iterator<move_only_counter> && !std::copyable<move_only_counter>);
+
+    struct move_only_range {
+        int first = 0;
+        int last = 0;
+
+        move_only_counter begin() const { return {first, last}; }
+        std::default_sentinel_t end() const { return {}; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    };
+
+    template <typename T>
+    np::vector<T> iota_vector(const std::size_t n) {
+        np::vector<T> v;
+        for (std::size_t i = 0; i < n; ++i) {
+            v.push_back(static_cast<T>(i * 7 + 3));
+        }
+        return v;
+    }
+
+    consteval int constexpr_sum() {
+        np::vector<int> v;
+        for (int i = 1; i <= 10; ++i) {
+            v.push_back(i);
+        }
+        v.insert(v.begin(), 100);
+        v.erase(v.begin() + 1);
+        np::erase_if(v, [](const int x) { return x < 50 && x % 2 == 0; });
+
+        int sum = 0;
+        for (const int x : v) {
+            sum += x;
+        }
+        return sum;
+    }
+
+    consteval std::size_t constexpr_bits() {
+        np::vector<bool> bits(130, false);
+        bits[3] = true;
+        bits[129] = true;
+        bits.flip(64);
+        return bits.count() * 1000 + bits.find_next(4);
+    }
+}
+
+/***************************/
+NP_TEST(vector_relocation_keeps_non_trivial_elements_intact) {
+    np::vector<self_ref> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+    NP_CHECK(all_intact(v));
+
+    v.insert(v.cbegin() + 10, self_ref(-1));
+    v.erase(v.cbegin() + 50);
+    v.pop_back();
+    v.shrink_to_fit();
+    NP_CHECK(all_intact(v));
+    NP_CHECK(v[10].value == -1);
+    NP_CHECK(v.size() == 99);
+}
+
+NP_TEST(vector_relocation_moves_trivially_relocatable_elements) {
+    np::vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(std::make_unique<int>(i));
+    }
+
+    v.insert(v.cbegin(), std::make_unique<int>(-1));
+    v.erase(v.cbegin() + 1);
+
+    NP_CHECK(*v[0] == -1);
+    for (int i = 1; i < 100; ++i) {
+        NP_CHECK(*v[i] == i);
+    }
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(growth_policies_choose_capacity) {
+    const std::allocator<int> alloc;
+    NP_CHECK(np::growth_2x::next_capacity(alloc, 0, 1) == 1);
+    NP_CHECK(np::growth_2x::next_capacity(alloc, 8, 9) == 16);
+    NP_CHECK(np::growth_2x::next_capacity(alloc, 8, 40) == 40);
+
+    NP_CHECK(np::growth_1_5x::next_capacity(alloc, 0, 1) == 1);
+    NP_CHECK(np::growth_1_5x::next_capacity(alloc, 10, 11) == 15);
+
+    const std::size_t rounded = np::growth_size_class::next_capacity(alloc, 10, 11);
+    NP_CHECK(rounded >= 15);
+    NP_CHECK(rounded * sizeof(int) == np::detail::round_to_size_class(15 * sizeof(int)));
+}
+
+NP_TEST(vector_with_growth_policy_grows_by_its_factor) {
+    np::vector<int, std::allocator<int>, np::growth_1_5x> v;
+    v.reserve(10);
+    for (int i = 0; i < 11; ++i) {
+        v.push_back(i);
+    }
+    NP_CHECK(v.capacity() == 15);
+}
+
+NP_TEST(malloc_allocator_grows_vector_in_place) {
+    np::vector<int, np::malloc_allocator<int>> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+    }
+    NP_CHECK(v.size() == 1000 && v[0] == 0 && v[999] == 999);
+}
+
+NP_TEST(aligned_allocator_aligns_vector_storage) {
+    np::vector<double, np::aligned_allocator<double, 64>> v(100, 1.5);
+    NP_CHECK(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0);
+
+    v.resize(1000, 2.5);
+    NP_CHECK(reinterpret_cast<std::uintptr_t>(v.data()) % 64 == 0 && v[0] == 1.5 && v[999] == 2.5);
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(small_vector_stays_inline_then_spills) {
+    np::small_vector<std::string, 4> v;
+    NP_CHECK(v.capacity() == 4);
+
+    for (int i = 0; i < 4; ++i) {
+        v.push_back(std::to_string(i));
+    }
+    NP_CHECK(v.capacity() == 4);
+
+    v.push_back("4");
+    NP_CHECK(v.capacity() > 4);
+    NP_CHECK(v.size() == 5 && v[4] == "4" && v[0] == "0");
+
+    np::small_vector<std::string, 4> small{"a", "b"};
+    np::small_vector<std::string, 4> copy = v;
+    NP_CHECK(copy.size() == 5 && copy[4] == "4" && copy[0] == "0");
+
+    std::swap(small, v);
+    NP_CHECK(small.size() == 5 && v.size() == 2 && v[1] == "b" && small[4] == "4");
+
+    np::small_vector<std::string, 4> moved = std::move(v);
+    NP_CHECK(moved.size() == 2 && moved[0] == "a");
+
+    moved = std::move(small);
+    NP_CHECK(moved.size() == 5 && moved[3] == "3");
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(vector_resize_for_overwrite_and_append_uninitialized) {
+    np::vector<int> v{1, 2};
+    v.resize_for_overwrite(5);
+    NP_CHECK(v.size() == 5 && v[0] == 1 && v[1] == 2);
+
+    int* tail = v.append_uninitialized(3);
+    NP_CHECK(tail == v.data() + 5 && v.size() == 8);
+    std::fill_n(tail, 3, 9);
+    NP_CHECK(v[7] == 9);
+
+    v.resize_for_overwrite(1);
+    NP_CHECK(v.size() == 1 && v[0] == 1);
+
+    np::vector<std::string> strings;
+    strings.resize_for_overwrite(3);
+    NP_CHECK(strings.size() == 3 && strings[2].empty());
+
+    // Уменьшение только разрушает хвост: блок и первые элементы остаются на месте
+    strings[0] = std::string(40, 'a');
+    const std::string* block = strings.data();
+    strings.resize_for_overwrite(1);
+    NP_CHECK(strings.size() == 1 && strings.data() == block && strings[0] == std::string(40, 'a'));
+}
+
+NP_TEST(default_init_allocator_leaves_resize_default_initialized) {
+    np::vector<int, np::default_init_allocator<int>> v;
+    v.resize(16);
+    NP_CHECK(v.size() == 16);
+
+    v.push_back(3);
+    NP_CHECK(v.size() == 17 && v[16] == 3);
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(vector_range_operations) {
+    np::vector<int> v{1, 2, 3};
+    const std::array<int, 3> extra{4, 5, 6};
+
+    v.append_range(extra);
+    NP_CHECK(holds(v, {1, 2, 3, 4, 5, 6}));
+
+    v.insert_range(v.cbegin() + 1, std::views::iota(10, 13));
+    NP_CHECK(holds(v, {1, 10, 11, 12, 2, 3, 4, 5, 6}));
+
+    v.assign_range(std::views::iota(0, 4));
+    NP_CHECK(holds(v, {0, 1, 2, 3}));
+
+    // Диапазон без размера: дописывается в конец и поворачивается на место
+    auto unsized = std::views::iota(7) | std::views::take_while([](const int x) { return x < 9; });
+    v.insert_range(v.cbegin() + 2, unsized);
+    NP_CHECK(holds(v, {0, 1, 7, 8, 2, 3}));
+}
+
+NP_TEST(vector_insert_range_reads_single_pass_sized_range_once) {
+    std::istringstream in("a b c d");
+    np::vector<std::string> v{"x", "y", "z"};
+    v.reserve(16);
+
+    v.insert_range(v.begin() + 1, single_pass_sized{{}, &in, 4});
+    NP_CHECK((v == np::vector<std::string>{"x", "a", "b", "c", "d", "y", "z"}));
+
+    np::vector<int> ints{7, 8};
+    ints.insert_range(ints.begin() + 1, move_only_range{0, 3});
+    NP_CHECK((ints == np::vector<int>{7, 0, 1, 2, 8}));
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(simd_search_matches_scalar) {
+    for (const std::size_t n : {0u, 1u, 15u, 16u, 17u, 63u, 64u, 65u, 1000u}) {
+        const np::vector<std::uint8_t> bytes = iota_vector<std::uint8_t>(n);
+        const np::vector<std::int32_t> ints = iota_vector<std::int32_t>(n);
+        const np::vector<double> doubles = iota_vector<double>(n);
+
+        for (const std::size_t at : {std::size_t(0), n / 2, n ? n - 1 : 0}) {
+            if (n == 0) {
+                break;
+            }
+
+            NP_CHECK(np::find(ints, ints[at]) - ints.cbegin() == std::find(ints.data(), ints.data() + n, ints[at]) - ints.data());
+            NP_CHECK(np::find(doubles, doubles[at]) - doubles.cbegin() == std::find(doubles.data(), doubles.data() + n, doubles[at]) - doubles.data());
+            NP_CHECK(np::count(bytes, bytes[at]) == static_cast<std::size_t>(std::count(bytes.data(), bytes.data() + n, bytes[at])));
+        }
+
+        NP_CHECK(np::find(ints, -1) == ints.cend());
+        NP_CHECK(!np::contains(ints, -1));
+
+        np::vector<std::int32_t> other = ints;
+        NP_CHECK(np::mismatch(ints, other).first == ints.cend());
+        if (n != 0) {
+            other[n - 1] = -5;
+            NP_CHECK(np::mismatch(ints, other).first - ints.cbegin() == static_cast<std::ptrdiff_t>(n - 1));
+        }
+    }
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(vector_parallel_construction) {
+    const np::parallel_policy policy{0, 0};
+
+    np::vector<std::string> filled(policy, 10000, std::string(20, 'x'));
+    NP_CHECK(filled.size() == 10000 && filled[9999] == std::string(20, 'x'));
+
+    np::vector<std::string> copy(policy, filled);
+    NP_CHECK(copy == filled);
+
+    np::vector<int> ints{1, 2};
+    ints.resize(policy, 50000, 7);
+    NP_CHECK(ints.size() == 50000 && ints[0] == 1 && ints[49999] == 7);
+}
+
+NP_TEST(parallel_for_splits_on_page_boundaries_of_the_buffer) {
+    const std::size_t page = np::detail::page_size();
+    np::vector<char> buffer(page * 64 + 64);
+
+    // Начало буфера намеренно не на границе страницы
+    const char* base = buffer.data() + 40;
+    const std::size_t count = page * 64 / 8;
+
+    std::mutex mutex;
+
+    np::detail::parallel_for(np::parallel_policy{0, 0}, base, count, 8,
+        [&](const std::size_t begin, const std::size_t end) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (begin != 0 && begin != end) {
+                NP_CHECK((reinterpret_cast<std::uintptr_t>(base) + begin * 8) % page == 0);
+            }
+        },
+        [](std::size_t, std::size_t) {});
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(mmap_allocator_backs_growing_vector) {
+    np::vector<std::uint64_t, np::mmap_allocator<std::uint64_t>> v;
+    for (std::uint64_t i = 0; i < 200000; ++i) {
+        v.push_back(i);
+    }
+
+    NP_CHECK(v.size() == 200000 && v[123456] == 123456 && v.back() == 199999);
+
+    v.shrink_to_fit();
+    NP_CHECK(v[199999] == 199999);
+}
+
+NP_TEST(pmr_vector_keeps_its_resource_on_assignment) {
+    np::test::tracking_resource first;
+    np::test::tracking_resource second;
+
+    {
+        np::pmr::vector<std::string> a(&first);
+        np::pmr::vector<std::string> b(&second);
+        for (int i = 0; i < 20; ++i) {
+            b.push_back(std::string(40, 'a'));
+        }
+
+        a = b;
+        NP_CHECK(a == b && a.get_allocator().resource() == &first);
+
+        a = std::move(b);
+        NP_CHECK(a.size() == 20 && a.get_allocator().resource() == &first);
+
+        np::pmr::vector<std::string> c(std::move(a), &second);
+        NP_CHECK(c.size() == 20 && c.get_allocator().resource() == &second);
+    }
+
+    NP_CHECK(first.foreign_frees() == 0 && second.foreign_frees() == 0);
+    NP_CHECK(first.live_blocks() == 0 && second.live_blocks() == 0);
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(vector_stats_count_allocations) {
+    np::vector<int, std::allocator<int>, np::growth_2x, 0, np::basic_stats> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+
+    const np::stats_snapshot snapshot = v.stats();
+    NP_CHECK(snapshot.allocations >= 1);
+    NP_CHECK(snapshot.allocations - snapshot.deallocations == 1);
+    NP_CHECK(snapshot.bytes_used == 100 * sizeof(int));
+    NP_CHECK(snapshot.bytes_reserved == v.capacity() * sizeof(int));
+    NP_CHECK(snapshot.peak_bytes_reserved >= snapshot.bytes_reserved);
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(vector_iterators_are_contiguous) {
+    static_assert(std::contiguous_iterator<np::vector<int>::iterator>);
+    static_assert(std::contiguous_iterator<np::vector<int>::const_iterator>);
+
+    np::vector<int> empty;
+    const std::span<int> none(empty.begin(), empty.end());
+    NP_CHECK(none.empty());
+
+    np::vector<int> v{1, 2, 3};
+    const std::span<int> all(v.begin(), v.end());
+    NP_CHECK(all.size() == 3 && all.data() == v.data());
+    NP_CHECK(std::to_address(v.end()) == v.data() + 3);
+
+#if NP_CHECKED_ITERATORS
+    NP_CHECK_THROWS(*v.end(), std::out_of_range);
+    NP_CHECK_THROWS(v.begin() + 4, std::out_of_range);
+#endif
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(serialization_round_trip) {
+    FILE* file = std::tmpfile();
+    NP_CHECK(file != nullptr);
+    const int fd = ::fileno(file);
+
+    const np::vector<std::uint32_t> source = iota_vector<std::uint32_t>(1000);
+    np::serialize(fd, source);
+    ::lseek(fd, 0, SEEK_SET);
+
+    np::vector<std::uint32_t> read;
+    np::deserialize(fd, read);
+    NP_CHECK(read == source);
+
+    std::fclose(file);
+}
+
+NP_TEST(deserialize_leaves_vector_empty_on_short_read) {
+    FILE* file = std::tmpfile();
+    NP_CHECK(file != nullptr);
+    const int fd = ::fileno(file);
+
+    np::serialize(fd, iota_vector<std::uint32_t>(100));
+    NP_CHECK(::ftruncate(fd, ::lseek(fd, 0, SEEK_CUR) - 8) == 0);
+    ::lseek(fd, 0, SEEK_SET);
+
+    np::vector<std::uint32_t> target{1, 2, 3};
+    NP_CHECK_THROWS(np::deserialize(fd, target), std::exception);
+    NP_CHECK(target.empty());
+
+    std::fclose(file);
+}
+
+NP_TEST(binary_view_over_buffer) {
+    FILE* file = std::tmpfile();
+    NP_CHECK(file != nullptr);
+    const int fd = ::fileno(file);
+
+    const np::vector<double> source = iota_vector<double>(64);
+    np::serialize(fd, source);
+
+    const auto bytes = static_cast<std::size_t>(::lseek(fd, 0, SEEK_CUR));
+    np::vector<std::byte> raw(bytes);
+    NP_CHECK(::pread(fd, raw.data(), bytes, 0) == static_cast<ssize_t>(bytes));
+    std::fclose(file);
+
+    const auto view = np::binary_view<double>::over(std::span<const std::byte>(raw.data(), raw.size()));
+    NP_CHECK(view.size() == 64 && view[10] == source[10]);
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(vector_erase_if_retain_and_erase_unordered) {
+    np::vector<self_ref> v;
+    for (int i = 0; i < 20; ++i) {
+        v.push_back(i);
+    }
+
+    NP_CHECK(np::erase_if(v, [](const self_ref& x) { return x.value % 3 == 0; }) == 7);
+    NP_CHECK(v.size() == 13 && v[0].value == 1 && v[2].value == 4 && all_intact(v));
+
+    NP_CHECK(v.retain([](const self_ref& x) { return x.value < 10; }) == 7);
+    NP_CHECK((v == np::vector<self_ref>{1, 2, 4, 5, 7, 8}));
+
+    v.erase_unordered(v.begin());
+    NP_CHECK(v.size() == 5 && v[0].value == 8 && all_intact(v));
+
+    np::vector<int> ints{1, 2, 1, 3, 1};
+    NP_CHECK(np::erase(ints, 1) == 3);
+    NP_CHECK((ints == np::vector<int>{2, 3}));
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(vector_bool_bulk_operations) {
+    np::vector<bool> a(200, false);
+    np::vector<bool> b(200, false);
+    for (std::size_t i = 0; i < 200; i += 3) {
+        a[i] = true;
+    }
+    for (std::size_t i = 0; i < 200; i += 5) {
+        b[i] = true;
+    }
+
+    NP_CHECK(a.count() == 67 && b.count() == 40);
+    NP_CHECK(a.find_first() == 0 && a.find_next(1) == 3);
+
+    // Обход до npos: find_next(npos) не переполняется и не начинает с нуля
+    std::size_t visited = 0;
+    for (std::size_t pos = b.find_first(); pos != b.npos; pos = b.find_next(pos)) {
+        ++visited;
+    }
+    NP_CHECK(visited == 40);
+    NP_CHECK(b.find_next(b.npos) == b.npos && b.find_next(b.npos, false) == b.npos);
+
+    np::vector<bool> both = a;
+    both &= b;
+    NP_CHECK(both.count() == 14);
+
+    np::vector<bool> either = a;
+    either |= b;
+    NP_CHECK(either.count() == 67 + 40 - 14);
+
+    a.flip();
+    NP_CHECK(a.count() == 133 && !a[0] && a[1]);
+
+    a.push_back(true);
+    NP_CHECK(a.size() == 201 && a.back());
+    NP_CHECK(np::count(a, true) == 134);
+}
+
+NP_TEST(simd_popcount_matches_scalar) {
+    std::mt19937_64 rng(7);
+    for (const std::size_t n : {0u, 1u, 3u, 4u, 7u, 8u, 33u, 1000u}) {
+        np::vector<std::uint64_t> words;
+        std::size_t expected = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            words.push_back(rng());
+            expected += static_cast<std::size_t>(std::popcount(words.back()));
+        }
+
+        NP_CHECK(np::simd::popcount(words.data(), words.size()) == expected);
+    }
+}
+
+NP_TEST(rank_select_matches_naive_scan) {
+    std::mt19937_64 rng(11);
+    np::vector<bool> bits;
+    for (std::size_t i = 0; i < 40000; ++i) {
+        bits.push_back(rng() % 7 == 0);
+    }
+
+    const np::rank_select<> index(bits);
+    NP_CHECK(index.count_ones() == bits.count());
+
+    std::size_t ones = 0;
+    for (std::size_t pos = 0; pos < bits.size(); ++pos) {
+        if (pos % 97 == 0) {
+            NP_CHECK(index.rank1(pos) == ones);
+        }
+        if (bits[pos]) {
+            if (ones % 13 == 0) {
+                NP_CHECK(index.select1(ones) == pos);
+            }
+            ++ones;
+        }
+    }
+
+    NP_CHECK(index.rank1(bits.size()) == ones);
+    NP_CHECK(index.select1(ones) == np::rank_select<>::npos);
+}
+/***************************/
+
+
+
+/***************************/
+NP_TEST(vector_in_constant_evaluation) {
+    static_assert(constexpr_sum() == 100 + 3 + 5 + 7 + 9);
+    static_assert(constexpr_bits() == 3 * 1000 + 64);
+    NP_CHECK(constexpr_sum() == 124);
+}
+/***************************/
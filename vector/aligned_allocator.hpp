@@ -0,0 +1,47 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace np {
+    // Аллокатор с выравниванием блока по Alignment байт (по умолчанию - строка кэша и ширина
+    // AVX-512), чтобы SIMD-циклы по буферу начинались с выровненной загрузки.
+    template <typename T, std::size_t Alignment = 64>
+    class aligned_allocator {
+        static_assert(std::has_single_bit(Alignment) && Alignment >= alignof(T), "Alignment must be a power of two not below alignof(T)");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template <typename U>
+        struct rebind {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+        aligned_allocator() noexcept = default;
+
+        template <typename U>
+        aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+        [[nodiscard]] T* allocate(const size_type n) {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* ptr, size_type) noexcept {
+            ::operator delete(ptr, std::align_val_t(Alignment));
+        }
+
+        template <typename U>
+        bool operator==(const aligned_allocator<U, Alignment>&) const noexcept {
+            return true;
+        }
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace np {
+    namespace detail {
+        // Общий заголовок двоичного формата: сериализованный np::vector и файл np::mapped_vector
+        // устроены одинаково, элементы идут сразу за заголовком, со смещения 64.
+        struct binary_header {
+            static constexpr char signature[8] = {'n', 'p', 'm', 'v', 'e', 'c', '\0', '\0'};
+            static constexpr std::uint32_t current_version = 1;
+            static constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byte_order;
+            std::uint32_t element_size;
+            std::uint32_t element_alignment;
+            std::uint64_t size;
+            std::uint64_t capacity;
+            std::uint8_t reserved[24];
+        };
+
+        static_assert(sizeof(binary_header) == 64);
+
+        template <typename T>
+        binary_header make_binary_header(const std::uint64_t size, const std::uint64_t capacity) noexcept {
+            binary_header header {};
+            std::memcpy(header.magic, binary_header::signature, sizeof(header.magic));
+            header.version = binary_header::current_version;
+            header.byte_order = binary_header::byte_order_mark;
+            header.element_size = sizeof(T);
+            header.element_alignment = alignof(T);
+            header.size = size;
+            header.capacity = capacity;
+            return header;
+        }
+
+        // payload_bytes - сколько байт доступно за заголовком (для потока - не ограничено)
+        template <typename T>
+        void validate_binary_header(const binary_header& header, const std::size_t payload_bytes, const char* who) {
+            const auto fail = [who](const char* what) {
+                throw std::runtime_error(std::string(who) + ": " + what);
+            };
+
+            if (std::memcmp(header.magic, binary_header::signature, sizeof(header.magic)) != 0) {
+                fail("bad signature");
+            }
+            if (header.version != binary_header::current_version) {
+                fail("unsupported version");
+            }
+            if (header.byte_order != binary_header::byte_order_mark) {
+                fail("data was written with a different byte order");
+            }
+            if (header.element_size != sizeof(T) || header.element_alignment != alignof(T)) {
+                fail("element layout mismatch");
+            }
+            if (header.size > header.capacity || header.capacity > payload_bytes / sizeof(T)) {
+                fail("data is truncated");
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace np {
+    // Снимок счётчиков контейнера для выгрузки в метрики
+    struct stats_snapshot {
+        std::size_t allocations = 0;
+        std::size_t deallocations = 0;
+        std::size_t bytes_allocated = 0;        // всего выделено за время жизни
+        std::size_t bytes_reserved = 0;         // занято блоками контейнера сейчас
+        std::size_t bytes_used = 0;             // из них под живые элементы (заполняет контейнер)
+        std::size_t peak_bytes_reserved = 0;
+        std::size_t reallocations = 0;          // переезды и расширения буфера
+        std::size_t element_moves = 0;
+        std::size_t element_copies = 0;
+    };
+
+    // Политика статистики - последний параметр шаблона np::vector, List и Map. Контейнер вызывает
+    //
+    //     on_allocate(bytes), on_deallocate(bytes)     - блок получен от аллокатора / возвращён ему
+    //     on_resize_block(old_bytes, new_bytes)        - блок изменил размер на месте (try_expand, realloc)
+    //     on_reallocation()                            - буфер переехал или вырос
+    //     on_move(n), on_copy(n)                       - контейнер переместил / скопировал n элементов
+    //     on_adopt(bytes), on_disown(bytes)            - блок перешёл к другому контейнеру (move, swap, splice)
+    //
+    // и отдаёт snapshot() наружу через stats(). no_stats пуст и хранится как [[no_unique_address]],
+    // так что без статистики контейнер не меняется ни в размере, ни в коде.
+    struct no_stats {
+        static constexpr bool enabled = false;
+
+        constexpr void on_allocate(std::size_t) noexcept {}
+        constexpr void on_deallocate(std::size_t) noexcept {}
+        constexpr void on_resize_block(std::size_t, std::size_t) noexcept {}
+        constexpr void on_reallocation() noexcept {}
+        constexpr void on_move(std::size_t) noexcept {}
+        constexpr void on_copy(std::size_t) noexcept {}
+        constexpr void on_adopt(std::size_t) noexcept {}
+        constexpr void on_disown(std::size_t) noexcept {}
+
+        constexpr stats_snapshot snapshot() const noexcept { return {}; }
+    };
+
+    // Счётчики на каждый экземпляр контейнера, без синхронизации (как и сам контейнер)
+    class basic_stats {
+    public:
+        static constexpr bool enabled = true;
+
+        constexpr void on_allocate(const std::size_t bytes) noexcept {
+            ++data_.allocations;
+            data_.bytes_allocated += bytes;
+            grow_(bytes);
+        }
+
+        constexpr void on_deallocate(const std::size_t bytes) noexcept {
+            ++data_.deallocations;
+            data_.bytes_reserved -= std::min(bytes, data_.bytes_reserved);
+        }
+
+        constexpr void on_resize_block(const std::size_t old_bytes, const std::size_t new_bytes) noexcept {
+            if (new_bytes > old_bytes) {
+                data_.bytes_allocated += new_bytes - old_bytes;
+                grow_(new_bytes - old_bytes);
+            }
+            else {
+                data_.bytes_reserved -= std::min(old_bytes - new_bytes, data_.bytes_reserved);
+            }
+        }
+
+        constexpr void on_reallocation() noexcept { ++data_.reallocations; }
+        constexpr void on_move(const std::size_t count) noexcept { data_.element_moves += count; }
+        constexpr void on_copy(const std::size_t count) noexcept { data_.element_copies += count; }
+
+        constexpr void on_adopt(const std::size_t bytes) noexcept { grow_(bytes); }
+        constexpr void on_disown(const std::size_t bytes) noexcept { data_.bytes_reserved -= std::min(bytes, data_.bytes_reserved); }
+
+        [[nodiscard]] constexpr stats_snapshot snapshot() const noexcept { return data_; }
+
+        constexpr void reset() noexcept {
+            const std::size_t reserved = data_.bytes_reserved;
+            data_ = {};
+            data_.bytes_reserved = data_.peak_bytes_reserved = reserved;
+        }
+
+    private:
+        constexpr void grow_(const std::size_t bytes) noexcept {
+            data_.bytes_reserved += bytes;
+            data_.peak_bytes_reserved = std::max(data_.peak_bytes_reserved, data_.bytes_reserved);
+        }
+
+        stats_snapshot data_;
+    };
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "relocation.hpp"
+
+namespace np {
+    // Адаптор аллокатора: construct(p) без аргументов выполняет default-init вместо value-init,
+    // поэтому resize(n) не зануляет новые элементы тривиальных типов. Остальное берётся из Allocator.
+    template <typename T, typename Allocator = std::allocator<T>>
+    class default_init_allocator : public Allocator {
+        using allocator_traits = std::allocator_traits<Allocator>;
+
+    public:
+        template <typename U>
+        struct rebind {
+            using other = default_init_allocator<U, typename allocator_traits::template rebind_alloc<U>>;
+        };
+
+        using Allocator::Allocator;
+
+        default_init_allocator() = default;
+
+        template <typename U, typename OtherAllocator>
+        default_init_allocator(const default_init_allocator<U, OtherAllocator>& other) noexcept
+            : Allocator(static_cast<const OtherAllocator&>(other)) {}
+
+        template <typename U>
+        void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+            ::new (static_cast<void*>(ptr)) U;
+        }
+
+        template <typename U, typename... Args>
+        void construct(U* ptr, Args&&... args) {
+            allocator_traits::construct(static_cast<Allocator&>(*this), ptr, std::forward<Args>(args)...);
+        }
+    };
+
+    template <typename T, typename Allocator>
+    struct is_trivially_relocatable<default_init_allocator<T, Allocator>> : is_trivially_relocatable<Allocator> {};
+}
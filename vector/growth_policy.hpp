@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+
+namespace np {
+    // Политика роста выбирает новую ёмкость, когда в буфере не осталось места:
+    //
+    //     static size_type next_capacity(const Allocator& alloc, size_type capacity, size_type required);
+    //
+    // required - минимально необходимая ёмкость, результат меньше неё vector всё равно не примет.
+
+    struct growth_2x {
+        template <typename Allocator>
+        static constexpr std::size_t next_capacity(const Allocator&, const std::size_t capacity, const std::size_t required) noexcept {
+            return std::max(capacity ? capacity * 2 : 1, required);
+        }
+    };
+
+    // Коэффициент 1.5 позволяет аллокатору переиспользовать ранее освобождённые блоки
+    // и заметно уменьшает недоиспользованную память на больших буферах.
+    struct growth_1_5x {
+        template <typename Allocator>
+        static constexpr std::size_t next_capacity(const Allocator&, const std::size_t capacity, const std::size_t required) noexcept {
+            return std::max(capacity > 1 ? capacity + capacity / 2 : capacity + 1, required);
+        }
+    };
+
+    namespace detail {
+        template <typename Allocator>
+        concept allocator_has_good_size = requires(const Allocator& alloc, std::size_t bytes) {
+            { alloc.good_size(bytes) } -> std::convertible_to<std::size_t>;
+        };
+
+        template <typename Allocator>
+        concept allocator_has_try_expand = requires(Allocator& alloc, typename std::allocator_traits<Allocator>::pointer ptr, std::size_t n) {
+            { alloc.try_expand(ptr, n, n) } -> std::convertible_to<bool>;
+        };
+
+        template <typename Allocator>
+        concept allocator_has_reallocate = requires(Allocator& alloc, typename std::allocator_traits<Allocator>::pointer ptr, std::size_t n) {
+            { alloc.reallocate(ptr, n, n) } -> std::convertible_to<typename std::allocator_traits<Allocator>::pointer>;
+        };
+
+        // Классы размеров в духе jemalloc: кратно 16 байтам до 128, дальше по четыре класса на удвоение.
+        constexpr std::size_t round_to_size_class(const std::size_t bytes) noexcept {
+            if (bytes <= 128) {
+                return (bytes + 15) & ~std::size_t(15);
+            }
+
+            const std::size_t spacing = std::size_t(1) << (std::bit_width(bytes - 1) - 3);
+            return (bytes + spacing - 1) & ~(spacing - 1);
+        }
+    }
+
+    // Рост в 1.5 раза, округлённый вверх до класса размера аллокатора, чтобы хвост блока,
+    // который аллокатор всё равно отдаст, шёл в ёмкость. Если аллокатор умеет good_size(bytes),
+    // используется он, иначе - таблица классов jemalloc.
+    struct growth_size_class {
+        template <typename Allocator>
+        static constexpr std::size_t next_capacity(const Allocator& alloc, const std::size_t capacity, const std::size_t required) noexcept {
+            using value_type = typename std::allocator_traits<Allocator>::value_type;
+
+            const std::size_t wanted = growth_1_5x::next_capacity(alloc, capacity, required);
+            if (wanted > std::allocator_traits<Allocator>::max_size(alloc)) {
+                return wanted;
+            }
+
+            std::size_t bytes = wanted * sizeof(value_type);
+            if constexpr (detail::allocator_has_good_size<Allocator>) {
+                bytes = alloc.good_size(bytes);
+            }
+            else {
+                bytes = detail::round_to_size_class(bytes);
+            }
+
+            return std::max(bytes / sizeof(value_type), wanted);
+        }
+    };
+}
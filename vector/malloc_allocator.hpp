@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace np {
+    // Аллокатор поверх malloc/realloc. Через reallocate vector растит буфер тривиально
+    // перемещаемых элементов вызовом realloc, который часто расширяет блок на месте.
+    template <typename T>
+    class malloc_allocator {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not guarantee extended alignment");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        malloc_allocator() noexcept = default;
+
+        template <typename U>
+        malloc_allocator(const malloc_allocator<U>&) noexcept {}
+
+        [[nodiscard]] T* allocate(const size_type n) {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+
+            void* ptr = std::malloc(n * sizeof(T));
+            if (ptr == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T*>(ptr);
+        }
+
+        void deallocate(T* ptr, size_type) noexcept {
+            std::free(ptr);
+        }
+
+        [[nodiscard]] T* reallocate(T* ptr, size_type, const size_type new_n) {
+            if (new_n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+
+            void* new_ptr = std::realloc(ptr, new_n * sizeof(T));
+            if (new_ptr == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T*>(new_ptr);
+        }
+
+        template <typename U>
+        bool operator==(const malloc_allocator<U>&) const noexcept {
+            return true;
+        }
+    };
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#if !defined(__linux__)
+    #error "np::mmap_allocator requires Linux (mmap/mremap/madvise)"
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace np {
+    enum class huge_pages {
+        none,           // обычные страницы
+        transparent,    // THP: блок выравнивается по huge page и помечается MADV_HUGEPAGE
+        explicit_pages  // MAP_HUGETLB из пула hugetlbfs; если пул пуст - обычные страницы того же размера
+    };
+
+    namespace detail {
+        inline std::size_t huge_page_size() noexcept {
+            static const std::size_t size = [] {
+                std::size_t kb = 2048;
+                if (std::FILE* meminfo = std::fopen("/proc/meminfo", "r")) {
+                    char line[256];
+                    while (std::fgets(line, sizeof(line), meminfo)) {
+                        if (std::sscanf(line, "Hugepagesize: %zu kB", &kb) == 1) {
+                            break;
+                        }
+                    }
+                    std::fclose(meminfo);
+                }
+                return kb * 1024;
+            }();
+
+            return size;
+        }
+    }
+
+    // Аллокатор на анонимных отображениях для больших долгоживущих векторов. Рост идёт через
+    // mremap: try_expand расширяет отображение на месте, reallocate переносит его целиком
+    // перестановкой таблиц страниц, без копирования (vector вызывает его только для тривиально
+    // перемещаемых T). Каждый блок занимает минимум одну страницу, для мелких векторов он не нужен.
+    template <typename T>
+    class mmap_allocator {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        mmap_allocator() noexcept = default;
+
+        explicit mmap_allocator(const huge_pages mode) noexcept : mode_(mode) {}
+
+        template <typename U>
+        mmap_allocator(const mmap_allocator<U>& other) noexcept : mode_(other.mode()) {}
+
+        [[nodiscard]] huge_pages mode() const noexcept {
+            return mode_;
+        }
+
+        [[nodiscard]] T* allocate(const size_type n) {
+            const std::size_t bytes = mapping_size_(n);
+
+            void* ptr = MAP_FAILED;
+            if (mode_ == huge_pages::explicit_pages) {
+                ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            }
+
+            if (ptr == MAP_FAILED) {
+                ptr = mode_ == huge_pages::transparent ? map_aligned_(bytes) : ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            }
+
+            if (ptr == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+
+            advise_(ptr, bytes);
+            return static_cast<T*>(ptr);
+        }
+
+        void deallocate(T* ptr, const size_type n) noexcept {
+            ::munmap(ptr, mapping_size_(n));
+        }
+
+        // Расширение отображения на месте, если за ним свободное адресное пространство
+        bool try_expand(T* ptr, const size_type old_n, const size_type new_n) {
+            const std::size_t old_bytes = mapping_size_(old_n);
+            const std::size_t new_bytes = mapping_size_(new_n);
+
+            if (new_bytes == old_bytes) {
+                return true;
+            }
+
+            if (::mremap(ptr, old_bytes, new_bytes, 0) == MAP_FAILED) {
+                return false;
+            }
+
+            advise_(reinterpret_cast<char*>(ptr) + old_bytes, new_bytes - old_bytes);
+            return true;
+        }
+
+        [[nodiscard]] T* reallocate(T* ptr, const size_type old_n, const size_type new_n) {
+            const std::size_t old_bytes = mapping_size_(old_n);
+            const std::size_t new_bytes = mapping_size_(new_n);
+
+            if (new_bytes == old_bytes) {
+                return ptr;
+            }
+
+            void* new_ptr = ::mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (new_ptr != MAP_FAILED) {
+                if (new_bytes > old_bytes) {
+                    advise_(static_cast<char*>(new_ptr) + old_bytes, new_bytes - old_bytes);
+                }
+                return static_cast<T*>(new_ptr);
+            }
+
+            // mremap не всегда доступен (например, для hugetlb на старых ядрах) - копируем
+            T* fresh = allocate(new_n);
+            std::memcpy(static_cast<void*>(fresh), static_cast<const void*>(ptr), std::min(old_bytes, new_bytes));
+            deallocate(ptr, old_n);
+            return fresh;
+        }
+
+        // Подсказка для growth_size_class: ёмкость добирается до границы отображения
+        [[nodiscard]] std::size_t good_size(const std::size_t bytes) const noexcept {
+            const std::size_t unit = granularity_();
+            return (bytes + unit - 1) / unit * unit;
+        }
+
+        template <typename U>
+        bool operator==(const mmap_allocator<U>& other) const noexcept {
+            return mode_ == other.mode();
+        }
+
+    private:
+        std::size_t granularity_() const noexcept {
+            return mode_ == huge_pages::none ? static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) : detail::huge_page_size();
+        }
+
+        std::size_t mapping_size_(const size_type n) const {
+            if (n > (std::numeric_limits<std::size_t>::max() - granularity_()) / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+
+            return good_size(std::max<std::size_t>(n * sizeof(T), 1));
+        }
+
+        // Отображение с началом на границе huge page, чтобы ядро могло сразу использовать THP
+        static void* map_aligned_(const std::size_t bytes) noexcept {
+            const std::size_t align = detail::huge_page_size();
+
+            void* raw = ::mmap(nullptr, bytes + align, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) {
+                return MAP_FAILED;
+            }
+
+            const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(raw);
+            const std::uintptr_t aligned = (begin + align - 1) & ~(std::uintptr_t(align) - 1);
+
+            if (aligned != begin) {
+                ::munmap(raw, aligned - begin);
+            }
+            if (const std::size_t tail = begin + bytes + align - (aligned + bytes); tail != 0) {
+                ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+            }
+
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        void advise_(void* ptr, const std::size_t bytes) const noexcept {
+            if (mode_ == huge_pages::transparent) {
+                ::madvise(ptr, bytes, MADV_HUGEPAGE);
+            }
+        }
+
+        huge_pages mode_ = huge_pages::transparent;
+    };
+}
@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+    #include <unistd.h>
+#endif
+
+namespace np {
+    // Политика параллельного заполнения/копирования больших векторов: vector(np::par, n, value)
+    struct parallel_policy {
+        unsigned threads = 0;               // 0 - все потоки пула
+        std::size_t min_bytes = 1u << 20;   // меньшие объёмы обрабатываются в вызывающем потоке
+    };
+
+    inline constexpr parallel_policy par{};
+
+    namespace detail {
+        inline std::size_t page_size() noexcept {
+#if defined(__linux__)
+            static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+            return size;
+#else
+            return 4096;
+#endif
+        }
+
+        // Пул потоков, закреплённых каждый за своим CPU из разрешённого процессу набора.
+        // Вызывающий поток выступает нулевым исполнителем. Часть i всегда достаётся потоку i,
+        // поэтому страницы, которых первым коснулся поток, оказываются на NUMA-узле его CPU.
+        class thread_pool {
+        public:
+            static thread_pool& instance() {
+                static thread_pool pool;
+                return pool;
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            [[nodiscard]] unsigned size() const noexcept {
+                return workers_count_ + 1;
+            }
+
+            // Выполняет job(i) для i в [0, participants) и ждёт завершения всех.
+            // Исключение из job(i) сохраняется в errors[i].
+            void run(const unsigned participants, const std::function<void(unsigned)>& job, std::exception_ptr* errors) {
+                std::lock_guard<std::mutex> run_lock(run_mutex_);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    job_ = &job;
+                    errors_ = errors;
+                    participants_ = participants;
+                    remaining_ = participants - 1;
+                    ++generation_;
+                }
+                wake_.notify_all();
+
+                execute_(0);
+
+                std::unique_lock<std::mutex> lock(mutex_);
+                done_.wait(lock, [this] { return remaining_ == 0; });
+                job_ = nullptr;
+            }
+
+            ~thread_pool() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stop_ = true;
+                }
+                wake_.notify_all();
+
+                for (unsigned i = 0; i < workers_count_; ++i) {
+                    workers_[i].join();
+                }
+            }
+
+        private:
+            thread_pool() {
+                unsigned cpus = std::max(1u, std::thread::hardware_concurrency());
+#if defined(__linux__)
+                cpu_set_t allowed;
+                CPU_ZERO(&allowed);
+                if (::sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+                    cpus = std::max(1, CPU_COUNT(&allowed));
+                }
+#endif
+                workers_count_ = cpus - 1;
+                workers_ = std::make_unique<std::thread[]>(workers_count_);
+
+                for (unsigned i = 0; i < workers_count_; ++i) {
+                    workers_[i] = std::thread([this, i] { loop_(i + 1); });
+                }
+
+#if defined(__linux__)
+                pin_to_cpus_(allowed);
+#endif
+            }
+
+#if defined(__linux__)
+            void pin_to_cpus_(const cpu_set_t& allowed) noexcept {
+                unsigned cpus[CPU_SETSIZE];
+                unsigned count = 0;
+                for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                    if (CPU_ISSET(cpu, &allowed)) {
+                        cpus[count++] = cpu;
+                    }
+                }
+
+                if (count == 0) {
+                    return;
+                }
+
+                // Исполнитель i (вызывающий поток - нулевой и остаётся где был) получает i-й разрешённый CPU
+                for (unsigned i = 0; i < workers_count_; ++i) {
+                    cpu_set_t one;
+                    CPU_ZERO(&one);
+                    CPU_SET(cpus[(i + 1) % count], &one);
+                    ::pthread_setaffinity_np(workers_[i].native_handle(), sizeof(one), &one);
+                }
+            }
+#endif
+
+            void execute_(const unsigned index) noexcept {
+                try {
+                    (*job_)(index);
+                } catch (...) {
+                    errors_[index] = std::current_exception();
+                }
+            }
+
+            void loop_(const unsigned index) {
+                std::size_t seen = 0;
+
+                for (;;) {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                        if (stop_) {
+                            return;
+                        }
+
+                        seen = generation_;
+                        if (index >= participants_) {
+                            continue;
+                        }
+                    }
+
+                    execute_(index);
+
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (--remaining_ == 0) {
+                        done_.notify_one();
+                    }
+                }
+            }
+
+            std::unique_ptr<std::thread[]> workers_;
+            unsigned workers_count_ = 0;
+
+            std::mutex run_mutex_;
+            std::mutex mutex_;
+            std::condition_variable wake_;
+            std::condition_variable done_;
+
+            const std::function<void(unsigned)>* job_ = nullptr;
+            std::exception_ptr* errors_ = nullptr;
+            unsigned participants_ = 0;
+            unsigned remaining_ = 0;
+            std::size_t generation_ = 0;
+            bool stop_ = false;
+        };
+
+        // Делит [0, count) на непрерывные части и вызывает fn(begin, end) для каждой на своём потоке.
+        // Границы частей выровнены по страницам в адресах буфера base, а не по номерам элементов:
+        // иначе страница на стыке достаётся обоим потокам и first-touch кладёт её на чужой узел.
+        // fn при исключении обязан откатить собственную часть; тогда для успешно завершённых частей
+        // вызывается undo(begin, end) и первое исключение пробрасывается.
+        template <typename Fn, typename Undo>
+        void parallel_for(const parallel_policy& policy, const void* base, const std::size_t count, const std::size_t element_size, Fn&& fn, Undo&& undo) {
+            if (count == 0) {
+                return;
+            }
+
+            thread_pool& pool = thread_pool::instance();
+            const unsigned workers = policy.threads != 0 ? std::min(policy.threads, pool.size()) : pool.size();
+
+            if (workers <= 1 || count * element_size < policy.min_bytes) {
+                fn(std::size_t(0), count);
+                return;
+            }
+
+            // Граница i - первый элемент, начинающийся не раньше страницы, следующей за равной долей.
+            // Если размер элемента делит размер страницы, элемент на границе начинается ровно на ней
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(base);
+            const std::size_t page = page_size();
+            const std::size_t chunk = (count + workers - 1) / workers;
+
+            std::unique_ptr<std::size_t[]> bounds(new std::size_t[workers + 1]);
+            bounds[0] = 0;
+            for (unsigned i = 1; i < workers; ++i) {
+                const std::uintptr_t nominal = address + std::min(count, i * chunk) * element_size;
+                const std::uintptr_t aligned = (nominal + page - 1) / page * page;
+                bounds[i] = std::min(count, (aligned - address + element_size - 1) / element_size);
+            }
+            bounds[workers] = count;
+
+            std::unique_ptr<std::exception_ptr[]> errors(new std::exception_ptr[workers]);
+            pool.run(workers, [&](const unsigned index) {
+                fn(bounds[index], bounds[index + 1]);
+            }, errors.get());
+
+            std::exception_ptr first_error;
+            for (unsigned i = 0; i < workers; ++i) {
+                if (errors[i] && !first_error) {
+                    first_error = errors[i];
+                }
+            }
+
+            if (first_error) {
+                for (unsigned i = 0; i < workers; ++i) {
+                    if (!errors[i]) {
+                        undo(bounds[i], bounds[i + 1]);
+                    }
+                }
+
+                std::rethrow_exception(first_error);
+            }
+        }
+    }
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "vector.hpp"
+
+namespace np {
+    // Индекс rank/select над битовым np::vector<bool> (раскладка Poppy, Zhou-Andersen-Kaminsky 2013).
+    //
+    // Биты делятся на нижние блоки по 2048 и базовые по 512. На нижний блок приходится одно
+    // 64-битное слово: 32 бита - число единиц от начала верхнего блока (2^32 бит), и три поля
+    // по 10 бит - единицы в первых трёх базовых блоках. Верхние блоки хранят абсолютные суммы,
+    // а каждая 8192-я единица - номер своего нижнего блока для select. Итого 3.1% к битам и не более
+    // 0.8% на отсчёты select.
+    //
+    // rank1 - константа: две выборки из каталога и popcount не более чем восьми слов.
+    // select1 - двоичный поиск между соседними отсчётами, затем те же слова и pdep.
+    //
+    // Индекс не владеет битами: он хранит указатель на вектор и читает его слова при запросе.
+    // После push_back / resize в конец достаточно extend() - пересчитывается только последний
+    // нижний блок. После изменения уже проиндексированных битов нужен rebuild().
+    template <typename Bits = vector<bool>>
+    class rank_select {
+    public:
+        using bits_type = Bits;
+        using size_type = std::size_t;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        rank_select() noexcept = default;
+
+        explicit rank_select(const bits_type& bits) : bits_(&bits) {
+            extend();
+        }
+
+        // Индексирует биты, добавленные после предыдущего extend / rebuild
+        void extend() {
+            const std::uint64_t* words = bits_->words().data();
+            const size_type word_count = bits_->words().size();
+            const size_type lower_count = (word_count + lower_words - 1) / lower_words;
+
+            // Последний нижний блок мог быть неполным - пересчитываем его вместе с новыми
+            const size_type first = indexed_ / lower_bits;
+            std::uint64_t ones = first < lower_.size() ? rank_at_lower_(first) : ones_;
+
+            lower_.resize(first);
+            upper_.resize((first + lowers_per_upper - 1) / lowers_per_upper);
+            while (!samples_.empty() && samples_.back() >= first) {
+                samples_.pop_back();
+            }
+
+            for (size_type block = first; block < lower_count; ++block) {
+                if (block % lowers_per_upper == 0) {
+                    upper_.push_back(ones);
+                }
+
+                const size_type begin = block * lower_words;
+                std::uint64_t entry = ones - upper_[block / lowers_per_upper];
+                std::uint64_t block_ones = 0;
+
+                for (size_type basic = 0; basic < lower_bits / basic_bits; ++basic) {
+                    const size_type from = std::min(word_count, begin + basic * basic_words);
+                    const size_type to = std::min(word_count, from + basic_words);
+                    const std::uint64_t count = simd::popcount(words + from, to - from);
+
+                    if (basic < 3) {
+                        entry |= count << (32 + 10 * basic);
+                    }
+                    block_ones += count;
+                }
+
+                lower_.push_back(entry);
+
+                for (std::uint64_t next = samples_.size() * sample_rate; next < ones + block_ones; next += sample_rate) {
+                    samples_.push_back(block);
+                }
+                ones += block_ones;
+            }
+
+            indexed_ = bits_->size();
+            ones_ = ones;
+        }
+
+        // Полная перестройка, например после изменения уже проиндексированных битов
+        void rebuild() {
+            upper_.clear();
+            lower_.clear();
+            samples_.clear();
+            indexed_ = 0;
+            ones_ = 0;
+            extend();
+        }
+
+        // Переключение на другой вектор (или тот же после перемещения) с перестройкой
+        void reset(const bits_type& bits) {
+            bits_ = &bits;
+            rebuild();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return indexed_;
+        }
+
+        [[nodiscard]] size_type count_ones() const noexcept {
+            return ones_;
+        }
+
+        // Объём каталога в байтах, без самих битов
+        [[nodiscard]] size_type directory_bytes() const noexcept {
+            return (upper_.capacity() + lower_.capacity() + samples_.capacity()) * sizeof(std::uint64_t);
+        }
+
+        // Число единиц в [0, pos), pos <= size()
+        [[nodiscard]] size_type rank1(const size_type pos) const noexcept {
+            const size_type block = pos / lower_bits;
+            if (block == lower_.size()) {
+                return ones_;
+            }
+
+            const std::uint64_t entry = lower_[block];
+            std::uint64_t result = upper_[block / lowers_per_upper] + (entry & 0xFFFFFFFF);
+
+            const size_type basic = pos % lower_bits / basic_bits;
+            for (size_type i = 0; i < basic; ++i) {
+                result += (entry >> (32 + 10 * i)) & 0x3FF;
+            }
+
+            const std::uint64_t* words = bits_->words().data();
+            const size_type word = pos / 64;
+            result += simd::popcount(words + block * lower_words + basic * basic_words, word - block * lower_words - basic * basic_words);
+
+            if (pos % 64 != 0) {
+                result += static_cast<std::uint64_t>(std::popcount(words[word] & ((std::uint64_t(1) << (pos % 64)) - 1)));
+            }
+
+            return result;
+        }
+
+        // Число нулей в [0, pos)
+        [[nodiscard]] size_type rank0(const size_type pos) const noexcept {
+            return pos - rank1(pos);
+        }
+
+        // Позиция k-й (с нуля) единицы или npos, если единиц не больше k
+        [[nodiscard]] size_type select1(size_type k) const noexcept {
+            if (k >= ones_) {
+                return npos;
+            }
+
+            // Последний нижний блок, до которого не больше k единиц, лежит между соседними отсчётами
+            const size_type sample = k / sample_rate;
+            size_type lo = samples_[sample];
+            size_type hi = sample + 1 < samples_.size() ? samples_[sample + 1] : lower_.size() - 1;
+
+            while (lo < hi) {
+                const size_type mid = lo + (hi - lo + 1) / 2;
+                if (rank_at_lower_(mid) <= k) {
+                    lo = mid;
+                }
+                else {
+                    hi = mid - 1;
+                }
+            }
+
+            const std::uint64_t entry = lower_[lo];
+            k -= rank_at_lower_(lo);
+
+            size_type basic = 0;
+            for (; basic < 3; ++basic) {
+                const size_type count = (entry >> (32 + 10 * basic)) & 0x3FF;
+                if (k < count) {
+                    break;
+                }
+                k -= count;
+            }
+
+            const std::uint64_t* words = bits_->words().data();
+            size_type word = lo * lower_words + basic * basic_words;
+            for (;; ++word) {
+                const size_type count = static_cast<size_type>(std::popcount(words[word]));
+                if (k < count) {
+                    break;
+                }
+                k -= count;
+            }
+
+            return word * 64 + simd::select_in_word(words[word], static_cast<unsigned>(k));
+        }
+
+    private:
+        static constexpr size_type basic_bits = 512;
+        static constexpr size_type lower_bits = 2048;
+        static constexpr size_type basic_words = basic_bits / 64;
+        static constexpr size_type lower_words = lower_bits / 64;
+        static constexpr size_type lowers_per_upper = (std::uint64_t(1) << 32) / lower_bits;
+        static constexpr size_type sample_rate = 8192;
+
+        // Единиц до начала нижнего блока
+        std::uint64_t rank_at_lower_(const size_type block) const noexcept {
+            return upper_[block / lowers_per_upper] + (lower_[block] & 0xFFFFFFFF);
+        }
+
+        const bits_type* bits_ = nullptr;
+
+        vector<std::uint64_t> upper_;
+        vector<std::uint64_t> lower_;
+        vector<std::uint64_t> samples_;
+
+        size_type indexed_ = 0;
+        std::uint64_t ones_ = 0;
+    };
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace np {
+    // Объект можно перенести побайтовым копированием, после чего исходник считается уничтоженным
+    // (деструктор для него не вызывается). Для своих типов достаточно специализации:
+    //
+    //     template <> struct np::is_trivially_relocatable<MyHandle> : std::true_type {};
+    template <typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    template <typename T>
+    struct is_trivially_relocatable<const T> : is_trivially_relocatable<T> {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+    template <typename First, typename Second>
+    struct is_trivially_relocatable<std::pair<First, Second>>
+        : std::conjunction<is_trivially_relocatable<First>, is_trivially_relocatable<Second>> {};
+
+    template <typename... Ts>
+    struct is_trivially_relocatable<std::tuple<Ts...>> : std::conjunction<is_trivially_relocatable<Ts>...> {};
+
+    template <typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    // Помощники constexpr: в константном вычислении memcpy/memmove недоступны, и перенос
+    // выполняется перемещением с уничтожением исходного элемента.
+    namespace detail {
+        template <typename Allocator, typename Pointer, typename SizeType>
+        constexpr void destroy_n(Allocator& alloc, Pointer first, SizeType count) noexcept {
+            using allocator_traits = std::allocator_traits<Allocator>;
+
+            if constexpr (!std::is_trivially_destructible_v<typename allocator_traits::value_type>) {
+                for (SizeType i = 0; i < count; ++i) {
+                    allocator_traits::destroy(alloc, std::to_address(first + i));
+                }
+            }
+        }
+
+        // Конструирует копии/перемещённые значения [first, first + count) в dest. При исключении
+        // откатывает уже созданные элементы, исходные остаются нетронутыми (move только если noexcept).
+        template <typename Allocator, typename Pointer, typename SizeType>
+        constexpr void uninitialized_move_if_noexcept_n(Allocator& alloc, Pointer first, SizeType count, Pointer dest) {
+            using allocator_traits = std::allocator_traits<Allocator>;
+
+            SizeType index = 0;
+            try {
+                for (; index < count; ++index) {
+                    allocator_traits::construct(alloc, std::to_address(dest + index), std::move_if_noexcept(first[index]));
+                }
+            } catch (...) {
+                destroy_n(alloc, dest, index);
+                throw;
+            }
+        }
+
+        // Переносит count элементов из [first, first + count) в неинициализированную память dest.
+        // Области не должны пересекаться. После возврата исходные элементы уничтожены.
+        template <typename Allocator, typename Pointer, typename SizeType>
+        constexpr void uninitialized_relocate_n(Allocator& alloc, Pointer first, SizeType count, Pointer dest) {
+            using value_type = typename std::allocator_traits<Allocator>::value_type;
+
+            if (count == 0) {
+                return;
+            }
+
+            if constexpr (is_trivially_relocatable_v<value_type>) {
+                if (!std::is_constant_evaluated()) {
+                    std::memcpy(static_cast<void*>(std::to_address(dest)), static_cast<const void*>(std::to_address(first)),
+                                count * sizeof(value_type));
+                    return;
+                }
+            }
+
+            uninitialized_move_if_noexcept_n(alloc, first, count, dest);
+            destroy_n(alloc, first, count);
+        }
+
+        // Сдвиг уже перенесённых байтов внутри одного буфера (области могут пересекаться).
+        template <typename Pointer, typename SizeType>
+        constexpr void relocate_overlapping_n(Pointer first, SizeType count, Pointer dest) noexcept {
+            using value_type = std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+
+            if (count == 0) {
+                return;
+            }
+
+            if (!std::is_constant_evaluated()) {
+                std::memmove(static_cast<void*>(std::to_address(dest)), static_cast<const void*>(std::to_address(first)),
+                             count * sizeof(value_type));
+                return;
+            }
+
+            // Поэлементно в сторону, где источник ещё не затёрт: слоты назначения свободны
+            // или уже покинуты перенесёнными элементами
+            for (SizeType i = 0; i < count; ++i) {
+                const SizeType k = dest < first ? i : count - 1 - i;
+                std::construct_at(std::to_address(dest + k), std::move(first[k]));
+                std::destroy_at(std::to_address(first + k));
+            }
+        }
+    }
+}
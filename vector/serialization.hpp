@@ -0,0 +1,287 @@
+#pragma once
+
+#if !defined(__unix__) && !defined(__APPLE__)
+    #error "np serialization requires POSIX writev/mmap"
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "../array/array.hpp"
+#include "binary_header.hpp"
+#include "vector.hpp"
+
+namespace np {
+    // Двоичная сериализация контейнеров тривиально копируемых T: заголовок binary_header и сырые
+    // байты элементов. Запись идёт одним writev без промежуточного буфера, чтение - либо копией
+    // прямо в память вектора, либо без копирования через binary_view поверх отображённого файла.
+    // Формат совпадает с файлом np::mapped_vector, так что снимок можно открыть и им.
+
+    namespace detail {
+        inline void write_all(const int fd, iovec* parts, int count) {
+            while (count != 0) {
+                const ssize_t written = ::writev(fd, parts, count);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "serialize: writev");
+                }
+
+                // Короткая запись: пропускаем дописанные части и сдвигаем начало текущей
+                std::size_t done = static_cast<std::size_t>(written);
+                while (count != 0 && done >= parts->iov_len) {
+                    done -= parts->iov_len;
+                    ++parts;
+                    --count;
+                }
+                if (count != 0) {
+                    parts->iov_base = static_cast<char*>(parts->iov_base) + done;
+                    parts->iov_len -= done;
+                }
+            }
+        }
+
+        inline void read_all(const int fd, void* dest, std::size_t bytes) {
+            char* out = static_cast<char*>(dest);
+            while (bytes != 0) {
+                const ssize_t got = ::read(fd, out, bytes);
+                if (got < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::system_error(errno, std::generic_category(), "deserialize: read");
+                }
+                if (got == 0) {
+                    throw std::runtime_error("deserialize: unexpected end of data");
+                }
+
+                out += got;
+                bytes -= static_cast<std::size_t>(got);
+            }
+        }
+
+        template <typename T>
+        binary_header read_binary_header(const int fd) {
+            binary_header header;
+            read_all(fd, &header, sizeof(header));
+            validate_binary_header<T>(header, static_cast<std::size_t>(-1), "deserialize");
+            return header;
+        }
+    }
+
+    template <typename T>
+    void serialize(const int fd, const std::span<const T> items) {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are written as raw bytes");
+
+        const detail::binary_header header = detail::make_binary_header<T>(items.size(), items.size());
+
+        iovec parts[2] = {
+            {const_cast<detail::binary_header*>(&header), sizeof(header)},
+            {const_cast<T*>(items.data()), items.size_bytes()}
+        };
+        detail::write_all(fd, parts, items.empty() ? 1 : 2);
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    void serialize(const int fd, const vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& v) {
+        serialize(fd, std::span<const T>(std::to_address(v.data()), v.size()));
+    }
+
+    template <typename T, std::size_t N>
+    void serialize(const int fd, const Handmade::Array<T, N>& a) {
+        serialize(fd, std::span<const T>(a.data(), a.size()));
+    }
+
+    // Читает снимок в v: память выделяется один раз под нужный размер, байты читаются прямо в неё.
+    // Если чтение оборвалось, v остаётся пустым, а не с недочитанными элементами
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    void deserialize(const int fd, vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& v) {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are read as raw bytes");
+
+        const detail::binary_header header = detail::read_binary_header<T>(fd);
+        if (header.size > v.max_size()) {
+            throw std::length_error("vector is too long");
+        }
+
+        v.clear();
+        v.resize_for_overwrite(static_cast<std::size_t>(header.size));
+
+        try {
+            detail::read_all(fd, std::to_address(v.data()), v.size() * sizeof(T));
+        } catch (...) {
+            v.clear();
+            throw;
+        }
+    }
+
+    template <typename T, std::size_t N>
+    void deserialize(const int fd, Handmade::Array<T, N>& a) {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are read as raw bytes");
+
+        const detail::binary_header header = detail::read_binary_header<T>(fd);
+        if (header.size > N) {
+            throw std::length_error("data sheet size is larger than acceptable range");
+        }
+
+        a.resize(static_cast<std::size_t>(header.size));
+
+        try {
+            detail::read_all(fd, a.data(), a.size() * sizeof(T));
+        } catch (...) {
+            a.resize(0);
+            throw;
+        }
+    }
+
+    // Только читающее представление снимка без копирования элементов. Либо владеет отображением
+    // файла (open), либо смотрит в чужой буфер (over), который должен пережить представление.
+    template <typename T>
+    class binary_view {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be viewed as raw bytes");
+
+    public:
+        using value_type = T;
+        using const_reference = const T&;
+        using const_pointer = const T*;
+        using const_iterator = const T*;
+        using size_type = std::size_t;
+
+        binary_view() noexcept = default;
+
+        static binary_view open(const std::string& path) {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "binary_view: open " + path);
+            }
+
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "binary_view: fstat");
+            }
+
+            const std::size_t bytes = static_cast<std::size_t>(info.st_size);
+            void* mapping = bytes != 0 ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+            const int error = errno;
+            ::close(fd);
+
+            if (mapping == MAP_FAILED) {
+                throw bytes == 0 ? std::system_error(EINVAL, std::generic_category(), "binary_view: empty file")
+                                 : std::system_error(error, std::generic_category(), "binary_view: mmap");
+            }
+
+            binary_view view;
+            view.mapping_ = mapping;
+            view.mapping_size_ = bytes;
+
+            view.attach_(static_cast<const char*>(mapping), bytes);
+            return view;
+        }
+
+        static binary_view over(const std::span<const std::byte> buffer) {
+            binary_view view;
+            view.attach_(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+            return view;
+        }
+
+        binary_view(const binary_view&) = delete;
+        binary_view& operator=(const binary_view&) = delete;
+
+        binary_view(binary_view&& other) noexcept
+            : mapping_(std::exchange(other.mapping_, nullptr)), mapping_size_(std::exchange(other.mapping_size_, 0)),
+              data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+        binary_view& operator=(binary_view&& other) noexcept {
+            if (this != &other) {
+                unmap_();
+                mapping_ = std::exchange(other.mapping_, nullptr);
+                mapping_size_ = std::exchange(other.mapping_size_, 0);
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+            }
+
+            return *this;
+        }
+
+        ~binary_view() {
+            unmap_();
+        }
+
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        const_pointer data() const noexcept { return data_; }
+
+        const_iterator begin() const noexcept { return data_; }
+        const_iterator end() const noexcept { return data_ + size_; }
+
+        const_reference operator[](const size_type index) const noexcept { return data_[index]; }
+
+        const_reference at(const size_type index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
+            }
+
+            return data_[index];
+        }
+
+        std::span<const T> span() const noexcept { return {data_, size_}; }
+
+    private:
+        void attach_(const char* bytes, const std::size_t count) {
+            if (count < sizeof(detail::binary_header)) {
+                unmap_();
+                throw std::runtime_error("binary_view: data is too small");
+            }
+
+            detail::binary_header header;
+            std::memcpy(&header, bytes, sizeof(header));
+
+            try {
+                detail::validate_binary_header<T>(header, count - sizeof(header), "binary_view");
+            } catch (...) {
+                unmap_();
+                throw;
+            }
+
+            const char* payload = bytes + sizeof(header);
+            if (reinterpret_cast<std::uintptr_t>(payload) % alignof(T) != 0) {
+                unmap_();
+                throw std::runtime_error("binary_view: payload is misaligned");
+            }
+
+            data_ = reinterpret_cast<const T*>(payload);
+            size_ = static_cast<size_type>(header.size);
+        }
+
+        void unmap_() noexcept {
+            if (mapping_ != nullptr) {
+                ::munmap(mapping_, mapping_size_);
+                mapping_ = nullptr;
+                mapping_size_ = 0;
+            }
+        }
+
+        void* mapping_ = nullptr;
+        std::size_t mapping_size_ = 0;
+
+        const T* data_ = nullptr;
+        size_type size_ = 0;
+    };
+}
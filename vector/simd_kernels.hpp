@@ -0,0 +1,716 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define NP_SIMD_X86 1
+    #include <immintrin.h>
+#else
+    #define NP_SIMD_X86 0
+#endif
+
+// Поиск, подсчёт и сравнение по непрерывным массивам арифметических типов.
+// Набор инструкций (SSE2 / AVX2 / AVX-512BW) выбирается один раз во время выполнения по CPUID,
+// на других платформах и компиляторах, а также в константном вычислении остаётся скалярный цикл.
+// Сравнение для float/double - обычное ==: NaN не равен ничему, -0.0 == +0.0.
+namespace np::simd {
+    template <typename T>
+    concept searchable = std::is_arithmetic_v<T> && !std::is_same_v<T, long double>
+        && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+    enum class isa { scalar, sse2, avx2, avx512 };
+
+    // Поразрядные операции над массивами 64-битных слов (битовые векторы)
+    enum class bit_op { bit_and, bit_or, bit_xor };
+
+    namespace detail {
+        template <typename T>
+        constexpr std::size_t find_scalar(const T* data, const std::size_t n, const T value) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (data[i] == value) {
+                    return i;
+                }
+            }
+
+            return n;
+        }
+
+        template <typename T>
+        constexpr std::size_t count_scalar(const T* data, const std::size_t n, const T value) noexcept {
+            std::size_t result = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                result += data[i] == value;
+            }
+
+            return result;
+        }
+
+        template <typename T>
+        constexpr std::size_t mismatch_scalar(const T* lhs, const T* rhs, const std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (!(lhs[i] == rhs[i])) {
+                    return i;
+                }
+            }
+
+            return n;
+        }
+
+        template <bit_op Op>
+        constexpr std::uint64_t apply_bit_op(const std::uint64_t lhs, const std::uint64_t rhs) noexcept {
+            if constexpr (Op == bit_op::bit_and) {
+                return lhs & rhs;
+            }
+            else if constexpr (Op == bit_op::bit_or) {
+                return lhs | rhs;
+            }
+            else {
+                return lhs ^ rhs;
+            }
+        }
+
+        template <bit_op Op>
+        constexpr void bitwise_scalar(std::uint64_t* dst, const std::uint64_t* src, const std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                dst[i] = apply_bit_op<Op>(dst[i], src[i]);
+            }
+        }
+
+        // Значение шириной width бит, начинающееся с бита offset; words[offset / 64 + 1] должен читаться
+        constexpr std::uint64_t extract_bits(const std::uint64_t* words, const std::size_t offset, const unsigned width) noexcept {
+            const std::size_t word = offset / 64;
+            const unsigned shift = static_cast<unsigned>(offset % 64);
+            const std::uint64_t mask = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+
+            // Сдвиг в два шага, чтобы при shift == 0 не сдвигать на 64
+            return ((words[word] >> shift) | ((words[word + 1] << 1) << (63 - shift))) & mask;
+        }
+
+        constexpr void unpack_scalar(const std::uint64_t* words, const std::size_t first, const unsigned width, const std::uint64_t base,
+                                  std::uint64_t* out, const std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = base + extract_bits(words, (first + i) * width, width);
+            }
+        }
+
+        // Позиция rank-го (с нуля) установленного бита: rank раз снимаем младшую единицу
+        constexpr unsigned select_in_word_scalar(std::uint64_t word, unsigned rank) noexcept {
+            for (; rank > 0; --rank) {
+                word &= word - 1;
+            }
+
+            return static_cast<unsigned>(std::countr_zero(word));
+        }
+
+        constexpr std::size_t popcount_scalar(const std::uint64_t* words, const std::size_t n) noexcept {
+            std::size_t result = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                result += static_cast<std::size_t>(std::popcount(words[i]));
+            }
+
+            return result;
+        }
+
+#if NP_SIMD_X86
+        /***************************/
+        // SSE2: маска movemask_epi8, на каждый совпавший элемент приходится sizeof(T) бит
+
+        template <typename T>
+        [[gnu::target("sse2"), gnu::always_inline]] inline __m128i broadcast_sse2(const T value) noexcept {
+            alignas(16) T lanes[16 / sizeof(T)];
+            for (auto& lane : lanes) {
+                lane = value;
+            }
+
+            return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+        }
+
+        template <typename T>
+        [[gnu::target("sse2"), gnu::always_inline]] inline std::uint32_t eq_mask_sse2(const __m128i lhs, const __m128i rhs) noexcept {
+            __m128i eq;
+            if constexpr (std::is_same_v<T, float>) {
+                eq = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(lhs), _mm_castsi128_ps(rhs)));
+            }
+            else if constexpr (std::is_same_v<T, double>) {
+                eq = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(lhs), _mm_castsi128_pd(rhs)));
+            }
+            else if constexpr (sizeof(T) == 1) {
+                eq = _mm_cmpeq_epi8(lhs, rhs);
+            }
+            else if constexpr (sizeof(T) == 2) {
+                eq = _mm_cmpeq_epi16(lhs, rhs);
+            }
+            else if constexpr (sizeof(T) == 4) {
+                eq = _mm_cmpeq_epi32(lhs, rhs);
+            }
+            else {
+                // cmpeq_epi64 появился только в SSE4.1: обе 32-битные половины должны совпасть
+                const __m128i eq32 = _mm_cmpeq_epi32(lhs, rhs);
+                eq = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+        }
+
+        template <typename T>
+        [[gnu::target("sse2")]] std::size_t find_sse2(const T* data, const std::size_t n, const T value) noexcept {
+            constexpr std::size_t lanes = 16 / sizeof(T);
+            const __m128i needle = broadcast_sse2(value);
+
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                const std::uint32_t mask = eq_mask_sse2<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle);
+                if (mask != 0) {
+                    return i + std::countr_zero(mask) / sizeof(T);
+                }
+            }
+
+            return i + find_scalar(data + i, n - i, value);
+        }
+
+        template <typename T>
+        [[gnu::target("sse2")]] std::size_t count_sse2(const T* data, const std::size_t n, const T value) noexcept {
+            constexpr std::size_t lanes = 16 / sizeof(T);
+            const __m128i needle = broadcast_sse2(value);
+
+            std::size_t bits = 0;
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                bits += std::popcount(eq_mask_sse2<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle));
+            }
+
+            return bits / sizeof(T) + count_scalar(data + i, n - i, value);
+        }
+
+        template <typename T>
+        [[gnu::target("sse2")]] std::size_t mismatch_sse2(const T* lhs, const T* rhs, const std::size_t n) noexcept {
+            constexpr std::size_t lanes = 16 / sizeof(T);
+
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                const std::uint32_t mask = ~eq_mask_sse2<T>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i)),
+                                                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i))) & 0xFFFFu;
+                if (mask != 0) {
+                    return i + std::countr_zero(mask) / sizeof(T);
+                }
+            }
+
+            return i + mismatch_scalar(lhs + i, rhs + i, n - i);
+        }
+        /***************************/
+
+
+
+        /***************************/
+        // AVX2: то же на 256-битных регистрах
+
+        template <typename T>
+        [[gnu::target("avx2"), gnu::always_inline]] inline __m256i broadcast_avx2(const T value) noexcept {
+            alignas(32) T lanes[32 / sizeof(T)];
+            for (auto& lane : lanes) {
+                lane = value;
+            }
+
+            return _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+        }
+
+        template <typename T>
+        [[gnu::target("avx2"), gnu::always_inline]] inline std::uint32_t eq_mask_avx2(const __m256i lhs, const __m256i rhs) noexcept {
+            __m256i eq;
+            if constexpr (std::is_same_v<T, float>) {
+                eq = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(lhs), _mm256_castsi256_ps(rhs), _CMP_EQ_OQ));
+            }
+            else if constexpr (std::is_same_v<T, double>) {
+                eq = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(lhs), _mm256_castsi256_pd(rhs), _CMP_EQ_OQ));
+            }
+            else if constexpr (sizeof(T) == 1) {
+                eq = _mm256_cmpeq_epi8(lhs, rhs);
+            }
+            else if constexpr (sizeof(T) == 2) {
+                eq = _mm256_cmpeq_epi16(lhs, rhs);
+            }
+            else if constexpr (sizeof(T) == 4) {
+                eq = _mm256_cmpeq_epi32(lhs, rhs);
+            }
+            else {
+                eq = _mm256_cmpeq_epi64(lhs, rhs);
+            }
+
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(eq));
+        }
+
+        template <typename T>
+        [[gnu::target("avx2")]] std::size_t find_avx2(const T* data, const std::size_t n, const T value) noexcept {
+            constexpr std::size_t lanes = 32 / sizeof(T);
+            const __m256i needle = broadcast_avx2(value);
+
+            std::size_t i = 0;
+            for (; i + 2 * lanes <= n; i += 2 * lanes) {
+                const std::uint32_t low = eq_mask_avx2<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+                const std::uint32_t high = eq_mask_avx2<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + lanes)), needle);
+                if ((low | high) != 0) {
+                    const std::uint64_t mask = (std::uint64_t(high) << 32) | low;
+                    return i + std::countr_zero(mask) / sizeof(T);
+                }
+            }
+
+            return i + find_sse2(data + i, n - i, value);
+        }
+
+        template <typename T>
+        [[gnu::target("avx2")]] std::size_t count_avx2(const T* data, const std::size_t n, const T value) noexcept {
+            constexpr std::size_t lanes = 32 / sizeof(T);
+            const __m256i needle = broadcast_avx2(value);
+
+            std::size_t bits = 0;
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                bits += std::popcount(eq_mask_avx2<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle));
+            }
+
+            return bits / sizeof(T) + count_scalar(data + i, n - i, value);
+        }
+
+        template <typename T>
+        [[gnu::target("avx2")]] std::size_t mismatch_avx2(const T* lhs, const T* rhs, const std::size_t n) noexcept {
+            constexpr std::size_t lanes = 32 / sizeof(T);
+
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                const std::uint32_t mask = ~eq_mask_avx2<T>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i)),
+                                                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i)));
+                if (mask != 0) {
+                    return i + std::countr_zero(mask) / sizeof(T);
+                }
+            }
+
+            return i + mismatch_scalar(lhs + i, rhs + i, n - i);
+        }
+        /***************************/
+
+
+
+        /***************************/
+        // AVX-512: сравнение сразу даёт маску по одному биту на элемент
+
+        template <typename T>
+        [[gnu::target("avx512f,avx512bw"), gnu::always_inline]] inline __m512i broadcast_avx512(const T value) noexcept {
+            alignas(64) T lanes[64 / sizeof(T)];
+            for (auto& lane : lanes) {
+                lane = value;
+            }
+
+            return _mm512_load_si512(lanes);
+        }
+
+        template <typename T>
+        [[gnu::target("avx512f,avx512bw"), gnu::always_inline]] inline std::uint64_t eq_mask_avx512(const __m512i lhs, const __m512i rhs) noexcept {
+            if constexpr (std::is_same_v<T, float>) {
+                return _mm512_cmp_ps_mask(_mm512_castsi512_ps(lhs), _mm512_castsi512_ps(rhs), _CMP_EQ_OQ);
+            }
+            else if constexpr (std::is_same_v<T, double>) {
+                return _mm512_cmp_pd_mask(_mm512_castsi512_pd(lhs), _mm512_castsi512_pd(rhs), _CMP_EQ_OQ);
+            }
+            else if constexpr (sizeof(T) == 1) {
+                return _mm512_cmpeq_epi8_mask(lhs, rhs);
+            }
+            else if constexpr (sizeof(T) == 2) {
+                return _mm512_cmpeq_epi16_mask(lhs, rhs);
+            }
+            else if constexpr (sizeof(T) == 4) {
+                return _mm512_cmpeq_epi32_mask(lhs, rhs);
+            }
+            else {
+                return _mm512_cmpeq_epi64_mask(lhs, rhs);
+            }
+        }
+
+        template <typename T>
+        [[gnu::target("avx512f,avx512bw")]] std::size_t find_avx512(const T* data, const std::size_t n, const T value) noexcept {
+            constexpr std::size_t lanes = 64 / sizeof(T);
+            const __m512i needle = broadcast_avx512(value);
+
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                const std::uint64_t mask = eq_mask_avx512<T>(_mm512_loadu_si512(data + i), needle);
+                if (mask != 0) {
+                    return i + std::countr_zero(mask);
+                }
+            }
+
+            return i + find_avx2(data + i, n - i, value);
+        }
+
+        template <typename T>
+        [[gnu::target("avx512f,avx512bw")]] std::size_t count_avx512(const T* data, const std::size_t n, const T value) noexcept {
+            constexpr std::size_t lanes = 64 / sizeof(T);
+            const __m512i needle = broadcast_avx512(value);
+
+            std::size_t result = 0;
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                result += std::popcount(eq_mask_avx512<T>(_mm512_loadu_si512(data + i), needle));
+            }
+
+            return result + count_avx2(data + i, n - i, value);
+        }
+
+        template <typename T>
+        [[gnu::target("avx512f,avx512bw")]] std::size_t mismatch_avx512(const T* lhs, const T* rhs, const std::size_t n) noexcept {
+            constexpr std::size_t lanes = 64 / sizeof(T);
+            constexpr std::uint64_t all = lanes == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << lanes) - 1;
+
+            std::size_t i = 0;
+            for (; i + lanes <= n; i += lanes) {
+                const std::uint64_t mask = ~eq_mask_avx512<T>(_mm512_loadu_si512(lhs + i), _mm512_loadu_si512(rhs + i)) & all;
+                if (mask != 0) {
+                    return i + std::countr_zero(mask);
+                }
+            }
+
+            return i + mismatch_avx2(lhs + i, rhs + i, n - i);
+        }
+        /***************************/
+
+
+
+        /***************************/
+        // Битовые векторы: поразрядные операции по 4 / 8 слов и подсчёт единиц
+
+        template <bit_op Op>
+        [[gnu::target("avx2")]] void bitwise_avx2(std::uint64_t* dst, const std::uint64_t* src, const std::size_t n) noexcept {
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+                const __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+
+                __m256i result;
+                if constexpr (Op == bit_op::bit_and) {
+                    result = _mm256_and_si256(lhs, rhs);
+                }
+                else if constexpr (Op == bit_op::bit_or) {
+                    result = _mm256_or_si256(lhs, rhs);
+                }
+                else {
+                    result = _mm256_xor_si256(lhs, rhs);
+                }
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+            }
+
+            bitwise_scalar<Op>(dst + i, src + i, n - i);
+        }
+
+        template <bit_op Op>
+        [[gnu::target("avx512f")]] void bitwise_avx512(std::uint64_t* dst, const std::uint64_t* src, const std::size_t n) noexcept {
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m512i lhs = _mm512_loadu_si512(dst + i);
+                const __m512i rhs = _mm512_loadu_si512(src + i);
+
+                __m512i result;
+                if constexpr (Op == bit_op::bit_and) {
+                    result = _mm512_and_si512(lhs, rhs);
+                }
+                else if constexpr (Op == bit_op::bit_or) {
+                    result = _mm512_or_si512(lhs, rhs);
+                }
+                else {
+                    result = _mm512_xor_si512(lhs, rhs);
+                }
+
+                _mm512_storeu_si512(dst + i, result);
+            }
+
+            bitwise_avx2<Op>(dst + i, src + i, n - i);
+        }
+
+        // Подсчёт по таблице на полубайты через pshufb (метод Мулы), суммы байтов - через sad_epu8
+        [[gnu::target("avx2,popcnt")]] inline std::size_t popcount_avx2(const std::uint64_t* words, const std::size_t n) noexcept {
+            const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                   0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low_mask = _mm256_set1_epi8(0x0F);
+
+            __m256i total = _mm256_setzero_si256();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+                const __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(chunk, low_mask));
+                const __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), low_mask));
+                total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+            }
+
+            std::size_t result = static_cast<std::size_t>(_mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1)
+                                                          + _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3));
+            for (; i < n; ++i) {
+                result += static_cast<std::size_t>(_mm_popcnt_u64(words[i]));
+            }
+
+            return result;
+        }
+
+        [[gnu::target("avx512f,avx512vpopcntdq,avx2,popcnt")]] inline std::size_t popcount_avx512(const std::uint64_t* words, const std::size_t n) noexcept {
+            __m512i total = _mm512_setzero_si512();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                total = _mm512_add_epi64(total, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+            }
+
+            // _mm512_reduce_add_epi64 в GCC 12 даёт ложное -Wuninitialized, складываем сами
+            alignas(64) std::uint64_t lanes[8];
+            _mm512_store_si512(lanes, total);
+
+            std::size_t result = 0;
+            for (const std::uint64_t lane : lanes) {
+                result += static_cast<std::size_t>(lane);
+            }
+
+            return result + popcount_avx2(words + i, n - i);
+        }
+
+        // popcount_avx2 собран с popcnt, а AVX2 наличия POPCNT не гарантирует
+        inline bool has_popcnt() noexcept {
+            static const bool supported = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("popcnt") != 0;
+            }();
+
+            return supported;
+        }
+
+        inline bool has_avx512_popcount() noexcept {
+            static const bool supported = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx512vpopcntdq") != 0;
+            }();
+
+            return supported;
+        }
+
+        // Распаковка: для каждой дорожки два gather (слово и следующее), сдвиги srlv/sllv.
+        // Сдвиг на 64 в srlv/sllv даёт ноль, так что граница слова не требует ветвления.
+        [[gnu::target("avx2")]] inline void unpack_avx2(const std::uint64_t* words, const std::size_t first, const unsigned width,
+                                                        const std::uint64_t base, std::uint64_t* out, const std::size_t n) noexcept {
+            const long long* source = reinterpret_cast<const long long*>(words);
+            const std::uint64_t mask_value = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+
+            const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(mask_value));
+            const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(base));
+            const __m256i bits = _mm256_set1_epi64x(64);
+            const __m256i low6 = _mm256_set1_epi64x(63);
+            const __m256i step = _mm256_set1_epi64x(static_cast<long long>(4 * width));
+
+            const long long start = static_cast<long long>(first * width);
+            __m256i offsets = _mm256_setr_epi64x(start, start + width, start + 2 * width, start + 3 * width);
+
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256i index = _mm256_srli_epi64(offsets, 6);
+                const __m256i shift = _mm256_and_si256(offsets, low6);
+
+                const __m256i low = _mm256_i64gather_epi64(source, index, 8);
+                const __m256i high = _mm256_i64gather_epi64(source + 1, index, 8);
+
+                __m256i value = _mm256_or_si256(_mm256_srlv_epi64(low, shift), _mm256_sllv_epi64(high, _mm256_sub_epi64(bits, shift)));
+                value = _mm256_add_epi64(_mm256_and_si256(value, mask), bias);
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), value);
+                offsets = _mm256_add_epi64(offsets, step);
+            }
+
+            unpack_scalar(words, first + i, width, base, out + i, n - i);
+        }
+
+        [[gnu::target("avx512f,avx2")]] inline void unpack_avx512(const std::uint64_t* words, const std::size_t first, const unsigned width,
+                                                                  const std::uint64_t base, std::uint64_t* out, const std::size_t n) noexcept {
+            const std::uint64_t mask_value = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+
+            const __m512i mask = _mm512_set1_epi64(static_cast<long long>(mask_value));
+            const __m512i bias = _mm512_set1_epi64(static_cast<long long>(base));
+            const __m512i bits = _mm512_set1_epi64(64);
+            const __m512i low6 = _mm512_set1_epi64(63);
+            const __m512i step = _mm512_set1_epi64(static_cast<long long>(8 * width));
+
+            const long long start = static_cast<long long>(first * width);
+            const long long w = width;
+            __m512i offsets = _mm512_setr_epi64(start, start + w, start + 2 * w, start + 3 * w, start + 4 * w, start + 5 * w, start + 6 * w, start + 7 * w);
+
+            // maskz-варианты с полной маской вместо обычных: у тех в GCC 12 источник - undefined,
+            // что даёт ложное -Wmaybe-uninitialized; код получается тот же
+            const __mmask8 all = 0xFF;
+
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m512i index = _mm512_maskz_srli_epi64(all, offsets, 6);
+                const __m512i shift = _mm512_and_si512(offsets, low6);
+
+                const __m512i low = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), all, index, words, 8);
+                const __m512i high = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), all, index, words + 1, 8);
+
+                __m512i value = _mm512_or_si512(_mm512_maskz_srlv_epi64(all, low, shift), _mm512_maskz_sllv_epi64(all, high, _mm512_sub_epi64(bits, shift)));
+                value = _mm512_add_epi64(_mm512_and_si512(value, mask), bias);
+
+                _mm512_storeu_si512(out + i, value);
+                offsets = _mm512_add_epi64(offsets, step);
+            }
+
+            unpack_avx2(words, first + i, width, base, out + i, n - i);
+        }
+
+        // pdep раскладывает 1 << rank по установленным битам слова, tzcnt даёт позицию
+        [[gnu::target("bmi,bmi2")]] inline unsigned select_in_word_bmi2(const std::uint64_t word, const unsigned rank) noexcept {
+            return static_cast<unsigned>(_tzcnt_u64(_pdep_u64(std::uint64_t(1) << rank, word)));
+        }
+
+        inline bool has_bmi2() noexcept {
+            static const bool supported = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("bmi2") != 0;
+            }();
+
+            return supported;
+        }
+        /***************************/
+#endif
+    }
+
+    inline isa active_isa() noexcept {
+#if NP_SIMD_X86
+        static const isa level = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+                return isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return isa::avx2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return isa::sse2;
+            }
+            return isa::scalar;
+        }();
+
+        return level;
+#else
+        return isa::scalar;
+#endif
+    }
+
+    // Индекс первого элемента, равного value, или n
+    template <searchable T>
+    constexpr std::size_t find(const T* data, const std::size_t n, const T value) noexcept {
+#if NP_SIMD_X86
+        if (!std::is_constant_evaluated()) {
+            switch (active_isa()) {
+                case isa::avx512: return detail::find_avx512(data, n, value);
+                case isa::avx2:   return detail::find_avx2(data, n, value);
+                case isa::sse2:   return detail::find_sse2(data, n, value);
+                case isa::scalar: break;
+            }
+        }
+#endif
+        return detail::find_scalar(data, n, value);
+    }
+
+    template <searchable T>
+    constexpr std::size_t count(const T* data, const std::size_t n, const T value) noexcept {
+#if NP_SIMD_X86
+        if (!std::is_constant_evaluated()) {
+            switch (active_isa()) {
+                case isa::avx512: return detail::count_avx512(data, n, value);
+                case isa::avx2:   return detail::count_avx2(data, n, value);
+                case isa::sse2:   return detail::count_sse2(data, n, value);
+                case isa::scalar: break;
+            }
+        }
+#endif
+        return detail::count_scalar(data, n, value);
+    }
+
+    // Индекс первой позиции, где lhs[i] != rhs[i], или n
+    template <searchable T>
+    constexpr std::size_t mismatch(const T* lhs, const T* rhs, const std::size_t n) noexcept {
+#if NP_SIMD_X86
+        if (!std::is_constant_evaluated()) {
+            switch (active_isa()) {
+                case isa::avx512: return detail::mismatch_avx512(lhs, rhs, n);
+                case isa::avx2:   return detail::mismatch_avx2(lhs, rhs, n);
+                case isa::sse2:   return detail::mismatch_sse2(lhs, rhs, n);
+                case isa::scalar: break;
+            }
+        }
+#endif
+        return detail::mismatch_scalar(lhs, rhs, n);
+    }
+
+    // dst[i] = dst[i] Op src[i] для n слов
+    template <bit_op Op>
+    constexpr void bitwise(std::uint64_t* dst, const std::uint64_t* src, const std::size_t n) noexcept {
+#if NP_SIMD_X86
+        if (!std::is_constant_evaluated()) {
+            switch (active_isa()) {
+                case isa::avx512: return detail::bitwise_avx512<Op>(dst, src, n);
+                case isa::avx2:   return detail::bitwise_avx2<Op>(dst, src, n);
+                case isa::sse2:
+                case isa::scalar: break;
+            }
+        }
+#endif
+        detail::bitwise_scalar<Op>(dst, src, n);
+    }
+
+    // out[i] = base + значение i-го поля шириной width бит, считая с поля first. За последним
+    // полем должно быть ещё одно читаемое слово: ядра читают слова парами.
+    constexpr void unpack(const std::uint64_t* words, const std::size_t first, const unsigned width, const std::uint64_t base,
+                          std::uint64_t* out, const std::size_t n) noexcept {
+#if NP_SIMD_X86
+        if (!std::is_constant_evaluated()) {
+            switch (active_isa()) {
+                case isa::avx512: return detail::unpack_avx512(words, first, width, base, out, n);
+                case isa::avx2:   return detail::unpack_avx2(words, first, width, base, out, n);
+                case isa::sse2:
+                case isa::scalar: break;
+            }
+        }
+#endif
+        detail::unpack_scalar(words, first, width, base, out, n);
+    }
+
+    // Позиция rank-го (с нуля) установленного бита слова; rank < popcount(word)
+    constexpr unsigned select_in_word(const std::uint64_t word, const unsigned rank) noexcept {
+#if NP_SIMD_X86
+        if (!std::is_constant_evaluated()) {
+            if (detail::has_bmi2()) {
+                return detail::select_in_word_bmi2(word, rank);
+            }
+        }
+#endif
+        return detail::select_in_word_scalar(word, rank);
+    }
+
+    // Число единичных битов в n словах
+    constexpr std::size_t popcount(const std::uint64_t* words, const std::size_t n) noexcept {
+#if NP_SIMD_X86
+        if (!std::is_constant_evaluated()) {
+            switch (active_isa()) {
+                case isa::avx512:
+                    if (detail::has_avx512_popcount() && detail::has_popcnt()) {
+                        return detail::popcount_avx512(words, n);
+                    }
+                    [[fallthrough]];
+                case isa::avx2:
+                    if (detail::has_popcnt()) {
+                        return detail::popcount_avx2(words, n);
+                    }
+                    break;
+                case isa::sse2:
+                case isa::scalar: break;
+            }
+        }
+#endif
+        return detail::popcount_scalar(words, n);
+    }
+}
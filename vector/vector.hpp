@@ -1,99 +1,167 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <limits>
 #include <memory>
 #include <memory_resource>
+#include <ranges>
 #include <stdexcept>
 #include <type_traits>
 
+#include "container_stats.hpp"
+#include "growth_policy.hpp"
+#include "parallel.hpp"
+#include "relocation.hpp"
+#include "simd_kernels.hpp"
+
+// Проверяемые итераторы np::vector, только по явному -DNP_CHECKED_ITERATORS=1. Значение меняет размер
+// итератора, поэтому все единицы трансляции программы должны собираться с одним и тем же: от NDEBUG
+// оно не зависит, чтобы отладочная и релизная части одной программы не разошлись.
+#ifndef NP_CHECKED_ITERATORS
+    #define NP_CHECKED_ITERATORS 0
+#endif
+
 namespace np {
-    template <typename T, typename Allocator = std::allocator<T>>
+    namespace detail {
+        // Буфер для первых N элементов прямо внутри объекта (small_vector)
+        template <typename T, std::size_t N>
+        struct inline_storage {
+            alignas(T) unsigned char bytes_[N * sizeof(T)];
+
+            T* data() noexcept { return reinterpret_cast<T*>(bytes_); }
+            const T* data() const noexcept { return reinterpret_cast<const T*>(bytes_); }
+        };
+
+        template <typename T>
+        struct inline_storage<T, 0> {
+            static constexpr T* data() noexcept { return nullptr; }
+        };
+    }
+
+    // Интерфейс, кроме перегрузок с parallel_policy, constexpr: вектор можно строить в consteval-функциях
+    // (транзиентное выделение C++20). Вся память освобождается до конца константного вычисления,
+    // наружу результат выносится копией - в Handmade::Array или std::array. Байтовый перенос
+    // и SIMD-ядра там заменяются поэлементными циклами; встроенный буфер small_vector
+    // (InlineCapacity > 0) во время компиляции недоступен.
+    template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = growth_2x, std::size_t InlineCapacity = 0, typename Stats = no_stats>
     class vector {
     public:
 
         // Allocator
         using allocator_type = Allocator;
         using allocator_traits = std::allocator_traits<allocator_type>;
+        using growth_policy = GrowthPolicy;
+        using stats_type = Stats;
 
         // Type
         using value_type = T;
         using reference = value_type&;
         using const_reference = const value_type&;
         using pointer = typename std::allocator_traits<allocator_type>::pointer;
-        using const_pointer = const pointer;
+        using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
         using size_type = std::size_t;
         using difference_type = std::ptrdiff_t;
 
     private:
 
-        size_type capacity_ = 0;
+        static_assert(InlineCapacity == 0 || std::is_same_v<pointer, value_type*>, "inline storage requires raw allocator pointers");
+
+        [[no_unique_address]] detail::inline_storage<value_type, InlineCapacity> inline_;
+
+        size_type capacity_ = InlineCapacity;
         size_type size_ = 0;
 
-        pointer data_ = nullptr;
+        pointer data_ = inline_.data();
 
         allocator_type allocator_;
 
+        [[no_unique_address]] stats_type stats_;
+
+        static constexpr bool relocatable_ = is_trivially_relocatable_v<value_type>;
+        static constexpr bool reallocatable_ = relocatable_ && detail::allocator_has_reallocate<allocator_type>;
+
+        // Итератор - обёртка над указателем, моделирует std::contiguous_iterator, поэтому стандартные
+        // алгоритмы сводятся к memmove/memcmp. С NP_CHECKED_ITERATORS он дополнительно хранит границы
+        // [begin_, end_) на момент создания и проверяет по ним разыменование и арифметику.
         template <bool is_const>
         class base_iterator {
         public:
             using pointer_type = std::conditional_t<is_const, const_pointer, pointer>;
             using reference_type = std::conditional_t<is_const, const_reference, reference>;
             using difference_type = std::ptrdiff_t;
-            using value_type = std::remove_cv_t<std::remove_pointer_t<pointer_type>>;
+            using value_type = T;
+            using element_type = std::conditional_t<is_const, const T, T>;
             using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::contiguous_iterator_tag;
 
             pointer_type ptr_ = nullptr;
+#if NP_CHECKED_ITERATORS
             pointer_type begin_ = nullptr;
             pointer_type end_ = nullptr;
+#endif
 
             /***************************/
-            base_iterator() noexcept = default;
-
-            explicit base_iterator(pointer_type ptr, pointer_type begin = nullptr, pointer_type end = nullptr) noexcept : ptr_(ptr), begin_(begin), end_(end) {}
-
-            base_iterator(const base_iterator& other) noexcept : ptr_(other.ptr_), begin_(other.begin_), end_(other.end_) {}
-
-            base_iterator(base_iterator&& other) noexcept = default; // *
-
-            base_iterator& operator=(const base_iterator& other) noexcept = default;
-
-            base_iterator& operator=(base_iterator&& other) noexcept = default; // *
+            constexpr base_iterator() noexcept = default;
+
+#if NP_CHECKED_ITERATORS
+            constexpr explicit base_iterator(pointer_type ptr, pointer_type begin = nullptr, pointer_type end = nullptr) noexcept : ptr_(ptr), begin_(begin), end_(end) {}
+#else
+            constexpr explicit base_iterator(pointer_type ptr, pointer_type = nullptr, pointer_type = nullptr) noexcept : ptr_(ptr) {}
+#endif
+
+            // iterator -> const_iterator
+            template <bool other_const> requires (is_const && !other_const)
+            constexpr base_iterator(const base_iterator<other_const>& other) noexcept
+#if NP_CHECKED_ITERATORS
+                : ptr_(other.ptr_), begin_(other.begin_), end_(other.end_) {}
+#else
+                : ptr_(other.ptr_) {}
+#endif
             /***************************/
 
 
             /***************************/
-            reference_type operator*() const {
+            constexpr reference_type operator*() const {
+                check_dereferenceable_(ptr_);
                 return *ptr_;
             }
 
-            pointer_type operator->() const {
-                return ptr_;
+            // std::to_address(it) идёт через operator-> и должен работать на end(), поэтому здесь
+            // проверяется только принадлежность диапазону, а не разыменуемость.
+            constexpr auto operator->() const {
+                check_in_range_(ptr_);
+                return std::to_address(ptr_);
+            }
+
+            constexpr reference_type operator[](const difference_type index) const {
+                check_dereferenceable_(ptr_ + index);
+                return ptr_[index];
             }
             /***************************/
 
 
 
             /***************************/
-            base_iterator& operator++() {
-                ++ptr_;
-                return *this;
+            constexpr base_iterator& operator++() {
+                return *this += 1;
             }
 
-            base_iterator& operator--() {
-                --ptr_;
-                return *this;
+            constexpr base_iterator& operator--() {
+                return *this -= 1;
             }
 
-            base_iterator operator++(int) {
+            constexpr base_iterator operator++(int) {
                 base_iterator temp = *this;
-                ++ptr_;
+                *this += 1;
                 return temp;
             }
 
-            base_iterator operator--(int) {
+            constexpr base_iterator operator--(int) {
                 base_iterator temp = *this;
-                --ptr_;
+                *this -= 1;
                 return temp;
             }
             /***************************/
@@ -101,77 +169,78 @@ namespace np {
 
 
             /***************************/
-            base_iterator operator+(difference_type value) const {
-                return base_iterator(ptr_ + value, begin_, end_);
+            constexpr base_iterator operator+(const difference_type value) const {
+                base_iterator temp = *this;
+                return temp += value;
             }
 
-            base_iterator operator-(difference_type value) const {
-                return base_iterator(ptr_ - value, begin_, end_);
+            friend constexpr base_iterator operator+(const difference_type value, const base_iterator& it) {
+                return it + value;
             }
 
-            difference_type operator-(const base_iterator& other) const {
+            constexpr base_iterator operator-(const difference_type value) const {
+                base_iterator temp = *this;
+                return temp -= value;
+            }
+
+            constexpr difference_type operator-(const base_iterator& other) const {
+                check_same_range_(other);
                 return ptr_ - other.ptr_;
             }
 
-            base_iterator& operator+=(difference_type value) {
+            constexpr base_iterator& operator+=(const difference_type value) {
+                check_in_range_(ptr_ + value);
                 ptr_ += value;
                 return *this;
             }
 
-            base_iterator& operator-=(difference_type value) {
+            constexpr base_iterator& operator-=(const difference_type value) {
+                check_in_range_(ptr_ - value);
                 ptr_ -= value;
                 return *this;
             }
-            
-            reference_type operator[](const difference_type index) noexcept {
-                return ptr_[index];
-            }
-            
-            const_reference operator[](const difference_type index) const noexcept {
-                return ptr_[index];
-            }
             /***************************/
 
 
 
             /***************************/
-            bool operator==(const base_iterator& other) const {
+            constexpr bool operator==(const base_iterator& other) const {
+                check_same_range_(other);
                 return ptr_ == other.ptr_;
             }
 
-            bool operator!=(const base_iterator& other) const {
-                return ptr_ != other.ptr_;
-            }
-
-            bool operator<(const base_iterator& other) const {
-                return ptr_ < other.ptr_;
-            }
-
-            bool operator<=(const base_iterator& other) const {
-                return ptr_ <= other.ptr_;
-            }
-
-            bool operator>(const base_iterator& other) const {
-                return ptr_ > other.ptr_;
-            }
-
-            bool operator>=(const base_iterator& other) const {
-                return ptr_ >= other.ptr_;
+            constexpr auto operator<=>(const base_iterator& other) const {
+                check_same_range_(other);
+                return std::to_address(ptr_) <=> std::to_address(other.ptr_);
             }
             /***************************/
 
+        private:
+#if NP_CHECKED_ITERATORS
+            constexpr void check_dereferenceable_(const pointer_type ptr) const {
+                if (ptr < begin_ || ptr >= end_) {
+                    throw std::out_of_range("Iterator is not dereferenceable");
+                }
+            }
 
-
-            /***************************/
-            explicit operator base_iterator<true>() const {
-                return base_iterator<true>(ptr_, begin_, end_);
+            constexpr void check_in_range_(const pointer_type ptr) const {
+                if (ptr < begin_ || ptr > end_) {
+                    throw std::out_of_range("Iterator out of range");
+                }
             }
 
-            explicit operator base_iterator<false>() const {
-                return base_iterator<false>(ptr_, begin_, end_);
+            constexpr void check_same_range_(const base_iterator& other) const {
+                if (begin_ != other.begin_) {
+                    throw std::logic_error("Iterators refer to different ranges");
+                }
             }
-            /***************************/
+#else
+            static constexpr void check_dereferenceable_(pointer_type) noexcept {}
+            static constexpr void check_in_range_(pointer_type) noexcept {}
+            static constexpr void check_same_range_(const base_iterator&) noexcept {}
+#endif
         };
+
     public:
         using iterator = base_iterator<false>;
         using const_iterator = base_iterator<true>;
@@ -180,288 +249,360 @@ namespace np {
         using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
     public:
-        vector() noexcept = default;
+        constexpr vector() noexcept = default;
 
-        explicit vector(const allocator_type& alloc = Allocator())  {
-            resize(alloc);
-        }
+        constexpr explicit vector(const allocator_type& alloc) noexcept : allocator_(alloc) {}
 
-        explicit vector(const size_type n) : capacity_(n), size_(n), data_(allocator_traits::allocate(allocator_, n)) {
-            std::uninitialized_default_construct_n(data_, n);
+        constexpr explicit vector(const size_type n, const allocator_type& alloc = allocator_type()) : allocator_(alloc) {
+            try {
+                reserve(n);
+                for (; size_ < n; ++size_) {
+                    allocator_traits::construct(allocator_, data_ + size_);
+                }
+            } catch (...) {
+                release_();
+                throw;
+            }
         }
 
-        vector(const size_type n, const_reference value) : capacity_(n), size_(n), data_(allocator_traits::allocate(allocator_, n)) {
-            std::uninitialized_fill_n(data_, n, value);
+        constexpr vector(const size_type n, const_reference value, const allocator_type& alloc = allocator_type()) : allocator_(alloc) {
+            try {
+                reserve(n);
+                for (; size_ < n; ++size_) {
+                    allocator_traits::construct(allocator_, data_ + size_, value);
+                }
+            } catch (...) {
+                release_();
+                throw;
+            }
         }
 
-        vector(const std::initializer_list<T>& list) : capacity_(list.size()), size_(list.size()), data_(allocator_traits::allocate(allocator_, capacity_)) {
-            std::uninitialized_copy(list.begin(), list.end(), data_);
-        }
+        // Заполнение частями на потоках пула; каждый поток первым касается своих страниц
+        vector(const parallel_policy& policy, const size_type n, const_reference value, const allocator_type& alloc = allocator_type())
+            : allocator_(alloc) {
+            reserve(n);
 
-        template <class InputIt>
-        vector(InputIt first, InputIt last) noexcept {
-            if (first == last) {
-                return;
+            try {
+                parallel_construct_(policy, data_, n, [&](pointer ptr, size_type) {
+                    allocator_traits::construct(allocator_, ptr, value);
+                });
+            } catch (...) {
+                release_();
+                throw;
             }
 
-            size_type distance = std::distance(first, last);
-            reserve(distance);
-
-            for (; first != last; ++first) {
-                push_back(*first);
-            }
+            size_ = n;
         }
 
-        vector (const vector& other) noexcept {
-            Allocator new_allocator = allocator_traits::select_on_container_copy_construction()
-                ? other.allocator_
-                : allocator_;
+        vector(const parallel_policy& policy, const vector& other)
+            : allocator_(allocator_traits::select_on_container_copy_construction(other.allocator_)) {
+            reserve(other.size_);
 
-            const_pointer new_arr = allocator_traits::allocate(new_allocator, other.capacity_);
-
-            size_type index = 0;
             try {
-                for (; index < other.size_; ++index) {
-                    allocator_traits::construct(new_allocator, new_arr + index, other[index]);
-                }
+                parallel_construct_(policy, data_, other.size_, [&](pointer ptr, const size_type index) {
+                    allocator_traits::construct(allocator_, ptr, other.data_[index]);
+                });
+                stats_.on_copy(other.size_);
             } catch (...) {
-                for (size_type i = 0; i < index; ++i) {
-                    allocator_traits::destroy(new_allocator, new_arr + i);
-                }
-
-                allocator_traits::deallocate(new_allocator, new_arr, other.capacity_);
+                release_();
                 throw;
             }
 
-            if (data_ != nullptr) {
-                for (size_type i = 0; i < other.size_; ++i) {
-                    allocator_traits::destroy(allocator_, data_ + i);
-                }
+            size_ = other.size_;
+        }
 
-                allocator_traits::deallocate(allocator_, data_, capacity_);
+        constexpr vector(const std::initializer_list<T>& list, const allocator_type& alloc = allocator_type()) : allocator_(alloc) {
+            try {
+                assign_(list.begin(), list.size());
+            } catch (...) {
+                release_();
+                throw;
             }
+        }
 
-            data_ = new_arr;
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-            allocator_ = new_allocator;
+        template <std::input_iterator InputIt>
+        constexpr vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : allocator_(alloc) {
+            try {
+                append_range(std::ranges::subrange(first, last));
+            } catch (...) {
+                release_();
+                throw;
+            }
         }
 
-        vector(vector&& other) noexcept {
-            if (this != &other) {
-                data_ = other.data_;
-                size_ = other.size_;
-                capacity_ = other.capacity_;
+        constexpr vector(const vector& other) : allocator_(allocator_traits::select_on_container_copy_construction(other.allocator_)) {
+            try {
+                assign_(other.data_, other.size_);
+            } catch (...) {
+                release_();
+                throw;
+            }
+        }
 
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+        constexpr vector(const vector& other, const allocator_type& alloc) : allocator_(alloc) {
+            try {
+                assign_(other.data_, other.size_);
+            } catch (...) {
+                release_();
+                throw;
             }
         }
 
-        vector& operator=(const vector& other) {
-            Allocator new_allocator = allocator_traits::propagate_on_container_copy_assignment::value
-                ? other.allocator_
-                : allocator_;
+        constexpr vector(vector&& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<value_type>)
+            : allocator_(std::move(other.allocator_)) {
+            take_(other);
+        }
 
-            pointer new_arr = allocator_traits::allocate(new_allocator, other.capacity_);
+        // С чужим (неравным) аллокатором буфер забрать нельзя - элементы перемещаются по одному
+        constexpr vector(vector&& other, const allocator_type& alloc) : allocator_(alloc) {
+            if constexpr (!allocator_traits::is_always_equal::value) {
+                if (allocator_ != other.allocator_) {
+                    try {
+                        assign_(std::make_move_iterator(other.data_), other.size_);
+                    } catch (...) {
+                        release_();
+                        throw;
+                    }
 
-            size_type index = 0;
-            try {
-                for (; index < other.size_; ++index) {
-                    allocator_traits::construct(new_allocator, new_arr + index, other[index]);
+                    other.clear();
+                    return;
                 }
-            } catch (...) {
-                for (size_type i = 0; i < index; ++i) {
-                    allocator_traits::destroy(new_allocator, new_arr + i);
-                }
-                allocator_traits::deallocate(new_allocator, new_arr, other.capacity_);
-                throw;
             }
 
-            if (data_ != nullptr) {
-                for (size_type i = 0; i < size_; ++i) {
-                    allocator_traits::destroy(allocator_, data_ + i);
+            take_(other);
+        }
+
+        constexpr vector& operator=(const vector& other) {
+            if (this != &other) {
+                if constexpr (allocator_traits::propagate_on_container_copy_assignment::value) {
+                    if (allocator_ != other.allocator_) {
+                        release_();
+                    }
+
+                    allocator_ = other.allocator_;
                 }
 
-                allocator_traits::deallocate(allocator_, data_, capacity_);
+                assign_(other.data_, other.size_);
             }
 
-            data_ = new_arr;
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-
             return *this;
         }
 
-        vector& operator=(vector&& other) noexcept {
+        constexpr vector& operator=(vector&& other) noexcept((allocator_traits::propagate_on_container_move_assignment::value || allocator_traits::is_always_equal::value)
+                                                   && (InlineCapacity == 0 || std::is_nothrow_move_constructible_v<value_type>)) {
             if (this != &other) {
-                if (data_ != nullptr) {
-                    for (size_type i = 0; i < size_; ++i) {
-                        allocator_traits::destroy(allocator_, data_ + i);
+                if constexpr (!allocator_traits::propagate_on_container_move_assignment::value && !allocator_traits::is_always_equal::value) {
+                    // Аллокатор остаётся свой, и если он не равен чужому - перемещаем поэлементно
+                    if (allocator_ != other.allocator_) {
+                        assign_(std::make_move_iterator(other.data_), other.size_);
+                        other.clear();
+                        return *this;
                     }
-
-                    allocator_traits::deallocate(allocator_, data_, capacity_);
                 }
 
-                data_ = other.data_;
-                size_ = other.size_;
-                capacity_ = other.capacity_;
+                release_();
 
                 if constexpr (allocator_traits::propagate_on_container_move_assignment::value) {
                     allocator_ = std::move(other.allocator_);
                 }
 
-                other.data_ = nullptr;
-                other.size_ = 0;
-                other.capacity_ = 0;
+                take_(other);
             }
 
             return *this;
         }
 
-        vector& operator=( std::initializer_list<value_type> ilist) {
-            if (data_ != nullptr) {
-                for (size_type i{}; i < ilist.size(); ++i) {
-                    allocator_traits::destroy(allocator_, data_ + i);
+        // Без propagate_on_container_swap аллокаторы обязаны быть равны, как и у std::vector
+        constexpr void swap(vector& other) noexcept(InlineCapacity == 0) {
+            if (this == &other) {
+                return;
+            }
+
+            if constexpr (InlineCapacity != 0) {
+                if (is_inline_() || other.is_inline_()) {
+                    vector temp(std::move(other));
+                    other = std::move(*this);
+                    *this = std::move(temp);
+                    return;
                 }
-                allocator_traits::deallocate(allocator_, data_, capacity_);
             }
 
-            data_ = allocator_traits::allocate(allocator_, ilist.size());
-            capacity_ = ilist.size();
-            size_ = 0;
+            if constexpr (allocator_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap(allocator_, other.allocator_);
+            }
 
-            try {
-                for (const auto& item : ilist) {
-                    allocator_traits::construct(allocator_, data_ + size_, item);
-                    ++size_;
-                }
-            } catch (...) {
-                // Откат при исключении
-                for (size_type i = 0; i < size_; ++i) {
-                    allocator_traits::destroy(allocator_, data_ + i);
-                }
-                allocator_traits::deallocate(allocator_, data_, capacity_);
-                throw;
+            stats_.on_disown(capacity_ * sizeof(value_type));
+            stats_.on_adopt(other.capacity_ * sizeof(value_type));
+            other.stats_.on_disown(other.capacity_ * sizeof(value_type));
+            other.stats_.on_adopt(capacity_ * sizeof(value_type));
+
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+
+        [[nodiscard]] constexpr allocator_type get_allocator() const noexcept {
+            return allocator_;
+        }
+
+        // Счётчики политики Stats; с no_stats - нулевой снимок
+        [[nodiscard]] constexpr stats_snapshot stats() const noexcept {
+            stats_snapshot snapshot = stats_.snapshot();
+            if constexpr (stats_type::enabled) {
+                snapshot.bytes_used = size_ * sizeof(value_type);
             }
 
+            return snapshot;
+        }
+
+        constexpr stats_type& stats_policy() noexcept { return stats_; }
+        constexpr const stats_type& stats_policy() const noexcept { return stats_; }
+
+        constexpr vector& operator=( std::initializer_list<value_type> ilist) {
+            assign_(ilist.begin(), ilist.size());
+
             return *this;
         }
 
-        void reserve(const size_type new_capacity) {
-            if (new_capacity <= capacity_) {
-                return;
+        template <std::input_iterator InputIt>
+        constexpr void assign(InputIt first, InputIt last) {
+            assign_range(std::ranges::subrange(first, last));
+        }
+
+        constexpr void assign(std::initializer_list<value_type> ilist) {
+            assign_(ilist.begin(), ilist.size());
+        }
+
+        template <std::ranges::input_range R>
+        constexpr void assign_range(R&& range) {
+            if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+                assign_(std::ranges::begin(range), static_cast<size_type>(std::ranges::distance(range)));
+            }
+            else {
+                clear();
+                for (auto&& item : range) {
+                    emplace_back(std::forward<decltype(item)>(item));
+                }
             }
+        }
 
-            const_pointer new_arr = allocator_traits::allocate(allocator_, new_capacity);
+        // Диапазон не должен ссылаться на элементы самого вектора
+        template <std::ranges::input_range R>
+        constexpr void append_range(R&& range) {
+            if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+                const size_type count = static_cast<size_type>(std::ranges::distance(range));
+                if (count > max_size() - size_) {
+                    throw std::length_error("vector is too long");
+                }
 
-            size_type index = 0;
-            try {
-                for (; index < size_; ++index) {
-                    allocator_traits::construct(allocator_, new_arr + index, std::move(data_[index]));
+                if (count > capacity_ - size_) {
+                    reallocate_(next_capacity_(size_ + count));
                 }
+
+                construct_copies_(data_ + size_, std::ranges::begin(range), count);
+                size_ += count;
             }
-            catch (...) {
-                allocator_traits::deallocate(allocator_, new_arr, capacity_);
-                throw;
+            else {
+                for (auto&& item : range) {
+                    emplace_back(std::forward<decltype(item)>(item));
+                }
             }
+        }
 
-            for (size_type i = 0; i < size_; ++i) {
-                allocator_traits::destroy(allocator_, data_ + i);
+        constexpr void reserve(const size_type new_capacity) {
+            if (new_capacity <= capacity_) {
+                return;
             }
 
-            allocator_traits::deallocate(allocator_, data_, new_capacity);
-
-            data_ = new_arr;
-            capacity_ = new_capacity;
+            reallocate_(new_capacity);
         }
 
-        void push_back(const_reference element) {
+        constexpr void push_back(const_reference element) {
+            stats_.on_copy(1);
             emplace_back(element);
         }
 
-        void push_back(value_type&& element) {
+        constexpr void push_back(value_type&& element) {
             emplace_back(std::move(element));
         }
 
         template<typename... Args>
-        void emplace_back(Args&&... args) {
+        constexpr void emplace_back(Args&&... args) {
             if (size_ == capacity_) {
-                reserve(capacity_ ? capacity_ * 2 : 1);
+                emplace_at_(size_, std::forward<Args>(args)...);
+                return;
             }
+
             allocator_traits::construct(allocator_, data_ + size_, std::forward<Args>(args)...);
             ++size_;
         }
 
-        void pop_back() {
+        constexpr void pop_back() {
             allocator_traits::destroy(allocator_, data_ + --size_);
         }
 
-        void clear() {
+        constexpr void clear() {
             for (; size_ > 0; --size_) {
                 allocator_traits::destroy(allocator_, data_ + size_ - 1);
             }
         }
 
-        void shrink_to_fit() {
+        constexpr void shrink_to_fit() {
             if (size_ < capacity_) {
-                const_pointer new_arr = allocator_traits::allocate(allocator_, size_);
-
-                size_type index = 0;
-                try {
-                    for (; index < size_; ++index) {
-                        allocator_traits::construct(allocator_, new_arr + index, data_[index]);
-                    }
-                } catch (...) {
-                    for (; index > 0; --index) {
-                        allocator_traits::destroy(allocator_, new_arr + index - 1);
-                    }
+                reallocate_(size_);
+            }
+        }
 
-                    allocator_traits::deallocate(allocator_, new_arr, size_);
-                    throw;
-                }
+        constexpr void resize(const size_type count) {
+            if (count > capacity_) {
+                reserve(count);
+            }
 
-                for (size_type i = size_; i < capacity_; ++i) {
-                    allocator_traits::destroy(allocator_, data_ + i);
+            if (count > size_) {
+                for (; size_ < count; ++size_) {
+                    allocator_traits::construct(allocator_, data_ + size_);
                 }
-
-                allocator_traits::deallocate(allocator_, data_, capacity_);
-
-                data_ = new_arr;
-                capacity_ = size_;
+            }
+            else {
+                detail::destroy_n(allocator_, data_ + count, size_ - count);
+                size_ = count;
             }
         }
 
-       void resize(const size_type count) {
+        // Как resize, но новые элементы инициализируются по умолчанию: для тривиальных T
+        // память не трогается вовсе, содержимое предполагается перезаписать (read, recv, memcpy)
+        constexpr void resize_for_overwrite(const size_type count) {
+            if (count <= size_) {
+                detail::destroy_n(allocator_, data_ + count, size_ - count);
+                size_ = count;
+                return;
+            }
+
             if (count > capacity_) {
                 reserve(count);
             }
 
-            if (count == 0) {
-                clear();
+            default_init_tail_(count - size_);
+        }
+
+        // Добавляет count инициализированных по умолчанию элементов и возвращает указатель на первый из них
+        constexpr pointer append_uninitialized(const size_type count) {
+            if (count > max_size() - size_) {
+                throw std::length_error("vector is too long");
             }
-            else {
-                if (count > size_) {
-                    try {
-                        for (size_type i = size_; i < count; ++i) {
-                            allocator_traits::construct(allocator_, data_ + i, value_type());
-                        }
-                    } catch (...) {
-                        throw;
-                    }
-                }
-                else {
-                    for (size_type i = count; i < size_; ++i) {
-                        allocator_traits::destroy(allocator_, data_ + i);
-                    }
-                }
+
+            if (count > capacity_ - size_) {
+                reallocate_(next_capacity_(size_ + count));
             }
 
-            size_ = count;
+            const size_type index = size_;
+            default_init_tail_(count);
+
+            return data_ + index;
         }
 
-        void resize(const size_type count, const_reference value) {
+        constexpr void resize(const size_type count, const_reference value) {
             if (count > capacity_) {
                 reserve(count);
             }
@@ -489,138 +630,237 @@ namespace np {
             size_ = count;
         }
 
-        [[nodiscard]] size_type size() const noexcept { return size_; }
-        [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
-
-        iterator insert(const_iterator pos, const_reference value) {
-            difference_type index = pos.ptr_ - data_;
-            if (size_ > capacity_ - 1) {
-                reserve(capacity_ ? capacity_ * 2 : 1);
+        void resize(const parallel_policy& policy, const size_type count, const_reference value) {
+            if (count <= size_) {
+                resize(count, value);
+                return;
             }
 
-            const_pointer ptr = data_ + index;
+            // value может ссылаться на элемент самого вектора, а reserve его переносит
+            const value_type fill(value);
+            reserve(count);
 
-            if (ptr < data_ + size_) {
-                std::uninitialized_copy(ptr, data_ + size_, ptr + 1);
-                allocator_traits::destroy(allocator_, ptr);
-            }
+            parallel_construct_(policy, data_ + size_, count - size_, [&](pointer ptr, size_type) {
+                allocator_traits::construct(allocator_, ptr, fill);
+            });
 
-            allocator_traits::construct(allocator_, ptr, value);
-            ++size_;
+            size_ = count;
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return capacity_; }
+
+        constexpr iterator insert(const_iterator pos, const_reference value) {
+            const size_type index = pos.ptr_ - data_;
+            emplace_at_(index, value);
 
             return iterator(data_ + index, data_, data_ + size_);
         }
 
-        iterator erase(iterator pos) {
-            if (pos.ptr_ < data_ || pos.ptr_ >= data_ + size_) {
-                throw std::out_of_range("Iterator out of range");
-            }
+        constexpr iterator insert(const_iterator pos, value_type&& value) {
+            const size_type index = pos.ptr_ - data_;
+            emplace_at_(index, std::move(value));
+
+            return iterator(data_ + index, data_, data_ + size_);
+        }
+
+        template <std::input_iterator InputIt>
+        constexpr iterator insert(const_iterator pos, InputIt first, InputIt last) {
+            return insert_range(pos, std::ranges::subrange(first, last));
+        }
+
+        constexpr iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+            return insert_range(pos, ilist);
+        }
 
-            pointer ptr = pos.ptr_;
+        // Диапазон не должен ссылаться на элементы самого вектора
+        template <std::ranges::input_range R>
+        constexpr iterator insert_range(const_iterator pos, R&& range) {
+            const size_type index = pos.ptr_ - data_;
 
-            for (pointer p = ptr + 1; p != data_ + size_; ++p) {
-                *(p - 1) = *p;
+            if constexpr (std::ranges::forward_range<R>) {
+                const size_type count = static_cast<size_type>(std::ranges::distance(range));
+                if (count > max_size() - size_) {
+                    throw std::length_error("vector is too long");
+                }
+
+                if (count > capacity_ - size_) {
+                    grow_with_gap_(index, count, next_capacity_(size_ + count), [&](pointer gap) {
+                        construct_copies_(gap, std::ranges::begin(range), count);
+                    });
+                }
+                else if (count != 0) {
+                    insert_in_place_(index, std::ranges::begin(range), count);
+                }
             }
+            else {
+                // Однопроходный диапазон читается один раз: дописывается в конец и поворачивается на место.
+                // Если размер известен, память выделяется заранее одним блоком
+                if constexpr (std::ranges::sized_range<R>) {
+                    const size_type count = static_cast<size_type>(std::ranges::size(range));
+                    if (count > max_size() - size_) {
+                        throw std::length_error("vector is too long");
+                    }
+
+                    if (count > capacity_ - size_) {
+                        reallocate_(next_capacity_(size_ + count));
+                    }
+                }
 
-            allocator_traits::destroy(allocator_, data_ + size_ - 1);
+                const size_type old_size = size_;
+                for (auto&& item : range) {
+                    emplace_back(std::forward<decltype(item)>(item));
+                }
 
-            --size_;
+                std::rotate(data_ + index, data_ + old_size, data_ + size_);
+            }
 
-            return iterator(ptr, data_, data_ + size_);
+            return iterator(data_ + index, data_, data_ + size_);
         }
 
-        iterator erase( const_iterator pos ) {
+        constexpr iterator erase(const_iterator pos) {
             if (pos.ptr_ < data_ || pos.ptr_ >= data_ + size_) {
                 throw std::out_of_range("Iterator out of range");
             }
 
-            const_pointer ptr = pos.ptr_;
+            pointer ptr = data_ + (pos.ptr_ - data_);
 
-            for (pointer p = ptr + 1; p != data_ + size_; ++p) {
-                *(p - 1) = *p;
+            if constexpr (relocatable_) {
+                allocator_traits::destroy(allocator_, ptr);
+                detail::relocate_overlapping_n(ptr + 1, data_ + size_ - ptr - 1, ptr);
             }
-
-            allocator_traits::destroy(allocator_, data_ + size_ - 1);
+            else {
+                std::move(ptr + 1, data_ + size_, ptr);
+                allocator_traits::destroy(allocator_, data_ + size_ - 1);
+            }
+            stats_.on_move(data_ + size_ - ptr - 1);
 
             --size_;
 
             return iterator(ptr, data_, data_ + size_);
         }
 
-        iterator erase(iterator first, iterator last) {
-            if (first.ptr_ < data_ || first.ptr_ >= data_ + size_ || last.ptr_ < data_ || last.ptr_ > data_ + size_ || first.ptr_ > last.ptr_) {
+        constexpr iterator erase(const_iterator first, const_iterator last) {
+            if (first.ptr_ < data_ || first.ptr_ > data_ + size_ || last.ptr_ < data_ || last.ptr_ > data_ + size_ || first.ptr_ > last.ptr_) {
                 throw std::out_of_range("Iterator out of range");
             }
 
-            pointer ptr_first = first.ptr_;
-            pointer ptr_last = last.ptr_;
+            pointer ptr_first = data_ + (first.ptr_ - data_);
+            pointer ptr_last = data_ + (last.ptr_ - data_);
+            const size_type count = ptr_last - ptr_first;
 
-            for (pointer p = ptr_last; p != data_ + size_; ++p) {
-                *(p - std::distance(ptr_first, ptr_last)) = *p;
+            if (count == 0) {
+                return iterator(ptr_first, data_, data_ + size_);
             }
 
-            for (size_type i = 0; i < std::distance(ptr_first, ptr_last); ++i) {
-                allocator_traits::destroy(allocator_, data_ + size_ - i);
+            if constexpr (relocatable_) {
+                detail::destroy_n(allocator_, ptr_first, count);
+                detail::relocate_overlapping_n(ptr_last, data_ + size_ - ptr_last, ptr_first);
+            }
+            else {
+                std::move(ptr_last, data_ + size_, ptr_first);
+                detail::destroy_n(allocator_, data_ + size_ - count, count);
             }
+            stats_.on_move(data_ + size_ - ptr_last);
 
-            size_ -= std::distance(ptr_first, ptr_last);
+            size_ -= count;
 
             return iterator(ptr_first, data_, data_ + size_);
         }
 
-        iterator erase(const_iterator pos) const noexcept {
-            return erase(static_cast<iterator>(pos));
+        constexpr iterator erase(iterator pos) {
+            return erase(static_cast<const_iterator>(pos));
         }
 
-        iterator erase(const_iterator first, const_iterator last) const {
-            return erase(static_cast<iterator>(first), static_cast<iterator>(last));
+        constexpr iterator erase(iterator first, iterator last) {
+            return erase(static_cast<const_iterator>(first), static_cast<const_iterator>(last));
         }
 
-        pointer data() {
-            return data_;
+        // Оставляет элементы, для которых pred истинен, за один устойчивый проход; возвращает число удалённых
+        template <typename Pred>
+        constexpr size_type retain(Pred pred) {
+            return remove_if_([&](const_reference element) { return !static_cast<bool>(pred(element)); });
+        }
+
+        // Удаление без сохранения порядка: на место pos переносится последний элемент
+        constexpr iterator erase_unordered(const_iterator pos) {
+            if (pos.ptr_ < data_ || pos.ptr_ >= data_ + size_) {
+                throw std::out_of_range("Iterator out of range");
+            }
+
+            pointer ptr = data_ + (pos.ptr_ - data_);
+            pointer last = data_ + size_ - 1;
+
+            if (ptr != last) {
+                if constexpr (relocatable_) {
+                    allocator_traits::destroy(allocator_, ptr);
+                    detail::relocate_overlapping_n(last, 1, ptr);
+                    --size_;
+                    stats_.on_move(1);
+                    return iterator(ptr, data_, data_ + size_);
+                }
+                else {
+                    *ptr = std::move(*last);
+                    stats_.on_move(1);
+                }
+            }
+
+            allocator_traits::destroy(allocator_, last);
+            --size_;
+
+            return iterator(ptr, data_, data_ + size_);
         }
 
-        const_pointer data() const {
+        constexpr iterator erase_unordered(iterator pos) {
+            return erase_unordered(static_cast<const_iterator>(pos));
+        }
+
+        constexpr pointer data() {
             return data_;
         }
 
-        size_type max_size() const {
-            return std::numeric_limits<std::size_t>::max(); // что это?
+        constexpr const_pointer data() const {
+            return data_;
+        }
 
+        constexpr size_type max_size() const {
+            return allocator_traits::max_size(allocator_);
         }
 
-        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
 
-        iterator begin() noexcept { return iterator(data_); }
-        const_iterator cbegin() const noexcept { return const_iterator(data_); }
+        constexpr iterator begin() noexcept { return iterator(data_, data_, data_ + size_); }
+        constexpr const_iterator begin() const noexcept { return const_iterator(data_, data_, data_ + size_); }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
 
-        iterator end() noexcept { return iterator(data_ + size_); }
-        const_iterator cend() const noexcept { return const_iterator(data_ + size_); }
+        constexpr iterator end() noexcept { return iterator(data_ + size_, data_, data_ + size_); }
+        constexpr const_iterator end() const noexcept { return const_iterator(data_ + size_, data_, data_ + size_); }
+        constexpr const_iterator cend() const noexcept { return end(); }
 
-        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
-        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
 
-        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
-        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
-        const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
-        const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
-        reference front() { return *data_; }
-        const_reference front() const { return *data_; }
+        constexpr reference front() { return *data_; }
+        constexpr const_reference front() const { return *data_; }
 
-        reference back() { return data_[size_ - 1]; }
-        const_reference back() const { return data_[size_ - 1]; }
+        constexpr reference back() { return data_[size_ - 1]; }
+        constexpr const_reference back() const { return data_[size_ - 1]; }
 
-        reference operator[](const size_type index) {
+        constexpr reference operator[](const size_type index) {
             return data_[index];
         }
 
-        const_reference operator[](const size_type index) const {
+        constexpr const_reference operator[](const size_type index) const {
             return data_[index];
         }
 
-        reference at(const size_type index) {
+        constexpr reference at(const size_type index) {
             if (index >= size_) {
                 throw std::out_of_range("Index out of range");
             }
@@ -628,7 +868,7 @@ namespace np {
             return data_[index];
         }
 
-        const_reference at(const size_type index) const {
+        constexpr const_reference at(const size_type index) const {
             if (index >= size_) {
                 throw std::out_of_range("Index out of range");
             }
@@ -636,14 +876,588 @@ namespace np {
             return data_[index];
         }
 
-        ~vector() {
-            if (data_) {
-                for (size_type i = 0; i < size_; ++i) {
-                    allocator_traits::destroy(allocator_, data_ + i);
+        constexpr ~vector() {
+            release_();
+        }
+
+    private:
+        constexpr bool is_inline_() const noexcept {
+            if constexpr (InlineCapacity == 0) {
+                return false;
+            }
+            else {
+                return data_ == inline_.data();
+            }
+        }
+
+        constexpr pointer allocate_(const size_type capacity) {
+            pointer ptr = allocator_traits::allocate(allocator_, capacity);
+            stats_.on_allocate(capacity * sizeof(value_type));
+            return ptr;
+        }
+
+        constexpr void deallocate_(pointer ptr, const size_type capacity) noexcept {
+            if (ptr != nullptr && ptr != inline_.data()) {
+                allocator_traits::deallocate(allocator_, ptr, capacity);
+                stats_.on_deallocate(capacity * sizeof(value_type));
+            }
+        }
+
+        // Копирование из итератора, разыменование которого даёт rvalue, - это перемещение
+        template <typename It>
+        constexpr void count_transfer_(const size_type count) noexcept {
+            if constexpr (std::is_rvalue_reference_v<std::iter_reference_t<It>>) {
+                stats_.on_move(count);
+            }
+            else {
+                stats_.on_copy(count);
+            }
+        }
+
+        // Уничтожает элементы и отдаёт память, оставляя пустой вектор на встроенном буфере
+        constexpr void release_() noexcept {
+            detail::destroy_n(allocator_, data_, size_);
+            deallocate_(data_, capacity_);
+
+            data_ = inline_.data();
+            capacity_ = InlineCapacity;
+            size_ = 0;
+        }
+
+        // Забирает содержимое other; *this должен быть пуст и без собственного блока
+        constexpr void take_(vector& other) {
+            if (other.is_inline_()) {
+                detail::uninitialized_relocate_n(allocator_, other.data_, other.size_, data_);
+                stats_.on_move(other.size_);
+                size_ = other.size_;
+                other.size_ = 0;
+                return;
+            }
+
+            if (other.data_ != nullptr) {
+                stats_.on_adopt(other.capacity_ * sizeof(value_type));
+                other.stats_.on_disown(other.capacity_ * sizeof(value_type));
+            }
+
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+
+            other.data_ = other.inline_.data();
+            other.size_ = 0;
+            other.capacity_ = InlineCapacity;
+        }
+
+        template <typename ForwardIt>
+        constexpr void assign_(ForwardIt first, const size_type count) {
+            if (count > capacity_) {
+                pointer new_arr = allocate_(count);
+
+                try {
+                    construct_copies_(new_arr, first, count);
+                } catch (...) {
+                    deallocate_(new_arr, count);
+                    throw;
                 }
 
-                allocator_traits::deallocate(allocator_, data_, capacity_);
+                detail::destroy_n(allocator_, data_, size_);
+                deallocate_(data_, capacity_);
+
+                data_ = new_arr;
+                capacity_ = count;
+                size_ = count;
+                return;
+            }
+
+            if constexpr (memcpy_compatible_<ForwardIt>) {
+                detail::destroy_n(allocator_, data_, size_);
+                size_ = 0;
+                construct_copies_(data_, first, count);
+                size_ = count;
+                return;
+            }
+
+            const size_type common = std::min(size_, count);
+            count_transfer_<ForwardIt>(count);
+            for (size_type i = 0; i < common; ++i, ++first) {
+                data_[i] = *first;
+            }
+
+            if (count < size_) {
+                detail::destroy_n(allocator_, data_ + count, size_ - count);
+                size_ = count;
+            }
+
+            for (; size_ < count; ++first) {
+                allocator_traits::construct(allocator_, data_ + size_, *first);
+                ++size_;
+            }
+        }
+
+        // construct_one(ptr, index) для index в [0, count), частями на потоках пула
+        template <typename ConstructOne>
+        void parallel_construct_(const parallel_policy& policy, pointer dest, const size_type count, ConstructOne&& construct_one) {
+            detail::parallel_for(policy, std::to_address(dest), count, sizeof(value_type),
+                [&](const size_type begin, const size_type end) {
+                    size_type index = begin;
+                    try {
+                        for (; index < end; ++index) {
+                            construct_one(dest + index, index);
+                        }
+                    } catch (...) {
+                        detail::destroy_n(allocator_, dest + begin, index - begin);
+                        throw;
+                    }
+                },
+                [&](const size_type begin, const size_type end) {
+                    detail::destroy_n(allocator_, dest + begin, end - begin);
+                });
+        }
+
+        // Непрерывный источник из тех же тривиально копируемых T можно скопировать одним memcpy
+        template <typename It>
+        static constexpr bool memcpy_compatible_ = std::contiguous_iterator<It>
+            && std::is_same_v<std::iter_value_t<It>, value_type>
+            && std::is_trivially_copyable_v<value_type>;
+
+        // Конструирует count элементов из first в неинициализированной памяти dest.
+        // При исключении уже созданные элементы уничтожаются.
+        template <typename It>
+        constexpr void construct_copies_(pointer dest, It first, const size_type count) {
+            count_transfer_<It>(count);
+
+            if constexpr (memcpy_compatible_<It>) {
+                if (!std::is_constant_evaluated()) {
+                    if (count != 0) {
+                        std::memcpy(static_cast<void*>(std::to_address(dest)), static_cast<const void*>(std::to_address(first)),
+                                    count * sizeof(value_type));
+                    }
+                    return;
+                }
+            }
+
+            size_type index = 0;
+            try {
+                for (; index < count; ++index, ++first) {
+                    allocator_traits::construct(allocator_, dest + index, *first);
+                }
+            } catch (...) {
+                detail::destroy_n(allocator_, dest, index);
+                throw;
+            }
+        }
+
+        // Устойчивое удаление всех элементов, для которых remove истинен, за один проход.
+        // Перемещаемые memcpy элементы переносятся непрерывными сериями через memmove.
+        template <typename Remove>
+        constexpr size_type remove_if_(Remove&& remove) {
+            const size_type old_size = size_;
+
+            if constexpr (relocatable_) {
+                size_type write = 0;
+                size_type run = 0;      // начало серии оставляемых элементов, ещё не перенесённой на write
+                size_type read = 0;
+
+                // Серия [run, read) переезжает на write; слоты удалённых элементов уже пусты
+                const auto flush = [&] {
+                    if (run != write) {
+                        detail::relocate_overlapping_n(data_ + run, read - run, data_ + write);
+                        stats_.on_move(read - run);
+                    }
+                    write += read - run;
+                };
+
+                try {
+                    for (; read < size_; ++read) {
+                        if (remove(data_[read])) {
+                            flush();
+                            allocator_traits::destroy(allocator_, data_ + read);
+                            run = read + 1;
+                        }
+                    }
+                } catch (...) {
+                    // Предикат бросил: хвост, включая непросмотренное, подтягивается к write
+                    read = size_;
+                    flush();
+                    size_ = write;
+                    throw;
+                }
+
+                flush();
+                size_ = write;
+            }
+            else {
+                size_type write = 0;
+                size_type read = 0;
+
+                try {
+                    for (; read < size_; ++read) {
+                        if (!remove(data_[read])) {
+                            if (read != write) {
+                                data_[write] = std::move(data_[read]);
+                                stats_.on_move(1);
+                            }
+                            ++write;
+                        }
+                    }
+                } catch (...) {
+                    // Непросмотренный хвост сдвигается к write, чтобы не оставить пустых мест в середине
+                    std::move(data_ + read, data_ + size_, data_ + write);
+                    stats_.on_move(size_ - read);
+                    write += size_ - read;
+                    detail::destroy_n(allocator_, data_ + write, size_ - write);
+                    size_ = write;
+                    throw;
+                }
+
+                detail::destroy_n(allocator_, data_ + write, size_ - write);
+                size_ = write;
             }
+
+            return old_size - size_;
+        }
+
+        // Вставка count элементов без перевыделения: capacity_ - size_ >= count.
+        // first проходится дважды, поэтому нужен прямой итератор
+        template <std::forward_iterator It>
+        constexpr void insert_in_place_(const size_type index, It first, const size_type count) {
+            const pointer position = data_ + index;
+            const size_type elems_after = size_ - index;
+
+            if constexpr (relocatable_) {
+                detail::relocate_overlapping_n(position, elems_after, position + count);
+                stats_.on_move(elems_after);
+                try {
+                    construct_copies_(position, first, count);
+                } catch (...) {
+                    detail::relocate_overlapping_n(position + count, elems_after, position);
+                    throw;
+                }
+
+                size_ += count;
+            }
+            else {
+                const pointer old_end = data_ + size_;
+
+                if (elems_after > count) {
+                    construct_copies_(old_end, std::make_move_iterator(old_end - count), count);
+                    size_ += count;
+                    std::move_backward(position, old_end - count, old_end);
+                    stats_.on_move(elems_after - count);
+                    std::copy_n(first, count, position);
+                    count_transfer_<It>(count);
+                }
+                else {
+                    It middle = std::next(first, elems_after);
+                    construct_copies_(old_end, middle, count - elems_after);
+                    size_ += count - elems_after;
+
+                    try {
+                        construct_copies_(data_ + size_, std::make_move_iterator(position), elems_after);
+                    } catch (...) {
+                        detail::destroy_n(allocator_, old_end, count - elems_after);
+                        size_ -= count - elems_after;
+                        throw;
+                    }
+
+                    size_ += elems_after;
+                    std::copy(first, middle, position);
+                    count_transfer_<It>(elems_after);
+                }
+            }
+        }
+
+        constexpr void default_init_tail_(const size_type count) {
+            if constexpr (std::is_trivially_default_constructible_v<value_type>) {
+                size_ += count;
+            }
+            else {
+                for (const size_type end = size_ + count; size_ < end; ++size_) {
+                    allocator_traits::construct(allocator_, data_ + size_);
+                }
+            }
+        }
+
+        constexpr size_type next_capacity_(const size_type required) const {
+            if (required > max_size()) {
+                throw std::length_error("vector is too long");
+            }
+
+            return std::clamp(growth_policy::next_capacity(allocator_, capacity_, required), required, max_size());
+        }
+
+        // Попытка нарастить текущий блок без переноса элементов (если аллокатор это умеет)
+        constexpr bool try_expand_(const size_type new_capacity) {
+            if constexpr (detail::allocator_has_try_expand<allocator_type>) {
+                if (data_ != nullptr && !is_inline_() && allocator_.try_expand(data_, capacity_, new_capacity)) {
+                    stats_.on_resize_block(capacity_ * sizeof(value_type), new_capacity * sizeof(value_type));
+                    stats_.on_reallocation();
+                    capacity_ = new_capacity;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        constexpr void reallocate_(const size_type new_capacity) {
+            if constexpr (InlineCapacity != 0) {
+                if (new_capacity <= InlineCapacity) {
+                    if (!is_inline_()) {
+                        detail::uninitialized_relocate_n(allocator_, data_, size_, inline_.data());
+                        deallocate_(data_, capacity_);
+                        stats_.on_reallocation();
+                        stats_.on_move(size_);
+
+                        data_ = inline_.data();
+                        capacity_ = InlineCapacity;
+                    }
+
+                    return;
+                }
+            }
+
+            if (new_capacity > capacity_ && try_expand_(new_capacity)) {
+                return;
+            }
+
+            if constexpr (reallocatable_) {
+                if (data_ != nullptr && !is_inline_() && new_capacity != 0) {
+                    data_ = allocator_.reallocate(data_, capacity_, new_capacity);
+                    stats_.on_resize_block(capacity_ * sizeof(value_type), new_capacity * sizeof(value_type));
+                    stats_.on_reallocation();
+                    capacity_ = new_capacity;
+                    return;
+                }
+            }
+
+            pointer new_arr = new_capacity != 0 ? allocate_(new_capacity) : nullptr;
+
+            try {
+                detail::uninitialized_relocate_n(allocator_, data_, size_, new_arr);
+            } catch (...) {
+                deallocate_(new_arr, new_capacity);
+                throw;
+            }
+
+            deallocate_(data_, capacity_);
+            stats_.on_reallocation();
+            stats_.on_move(size_);
+
+            data_ = new_arr;
+            capacity_ = new_capacity;
+        }
+
+        template <typename... Args>
+        constexpr void emplace_at_(const size_type index, Args&&... args) {
+            if (size_ == capacity_) {
+                const size_type new_capacity = next_capacity_(size_ + 1);
+
+                if (!try_expand_(new_capacity)) {
+                    if constexpr (!reallocatable_) {
+                        grow_with_gap_(index, 1, new_capacity, [&](pointer gap) {
+                            allocator_traits::construct(allocator_, gap, std::forward<Args>(args)...);
+                        });
+                        return;
+                    }
+                }
+            }
+
+            if (index == size_ && size_ < capacity_) {
+                allocator_traits::construct(allocator_, data_ + size_, std::forward<Args>(args)...);
+            }
+            else if constexpr (relocatable_) {
+                if (std::is_constant_evaluated()) {
+                    // Байтовый перенос во время компиляции недоступен: значение создаётся на стеке, хвост
+                    // сдвигается конструкторами. Рост сюда не доходит - без reallocate он прошёл через grow_with_gap_
+                    value_type temp(std::forward<Args>(args)...);
+                    detail::relocate_overlapping_n(data_ + index, size_ - index, data_ + index + 1);
+                    allocator_traits::construct(allocator_, data_ + index, std::move(temp));
+                    stats_.on_move(size_ - index);
+                    ++size_;
+                    return;
+                }
+
+                // Аргументы могут ссылаться на элемент хвоста, поэтому значение создаётся до сдвига
+                alignas(value_type) unsigned char buffer[sizeof(value_type)];
+                value_type* temp = reinterpret_cast<value_type*>(buffer);
+                allocator_traits::construct(allocator_, temp, std::forward<Args>(args)...);
+
+                if (size_ == capacity_) {
+                    try {
+                        reallocate_(next_capacity_(size_ + 1));
+                    } catch (...) {
+                        allocator_traits::destroy(allocator_, temp);
+                        throw;
+                    }
+                }
+
+                detail::relocate_overlapping_n(data_ + index, size_ - index, data_ + index + 1);
+                stats_.on_move(size_ - index);
+                std::memcpy(static_cast<void*>(std::to_address(data_ + index)), static_cast<const void*>(temp), sizeof(value_type));
+            }
+            else {
+                value_type temp(std::forward<Args>(args)...);
+
+                allocator_traits::construct(allocator_, data_ + size_, std::move(data_[size_ - 1]));
+                ++size_;
+                std::move_backward(data_ + index, data_ + size_ - 2, data_ + size_ - 1);
+                data_[index] = std::move(temp);
+                stats_.on_move(size_ - index);
+                return;
+            }
+
+            ++size_;
+        }
+
+        // Рост с переносом в новый блок: сначала construct_gap создаёт gap новых элементов
+        // на позиции index (пока аргументы ещё валидны), затем переносятся старые
+        template <typename ConstructGap>
+        constexpr void grow_with_gap_(const size_type index, const size_type gap, const size_type new_capacity, ConstructGap&& construct_gap) {
+            pointer new_arr = allocate_(new_capacity);
+
+            try {
+                construct_gap(new_arr + index);
+            } catch (...) {
+                deallocate_(new_arr, new_capacity);
+                throw;
+            }
+
+            if constexpr (relocatable_) {
+                detail::uninitialized_relocate_n(allocator_, data_, index, new_arr);
+                detail::uninitialized_relocate_n(allocator_, data_ + index, size_ - index, new_arr + index + gap);
+            }
+            else {
+                try {
+                    detail::uninitialized_move_if_noexcept_n(allocator_, data_, index, new_arr);
+                    try {
+                        detail::uninitialized_move_if_noexcept_n(allocator_, data_ + index, size_ - index, new_arr + index + gap);
+                    } catch (...) {
+                        detail::destroy_n(allocator_, new_arr, index);
+                        throw;
+                    }
+                } catch (...) {
+                    detail::destroy_n(allocator_, new_arr + index, gap);
+                    deallocate_(new_arr, new_capacity);
+                    throw;
+                }
+
+                detail::destroy_n(allocator_, data_, size_);
+            }
+
+            deallocate_(data_, capacity_);
+            stats_.on_reallocation();
+            stats_.on_move(size_);
+
+            data_ = new_arr;
+            capacity_ = new_capacity;
+            size_ += gap;
         }
     };
+
+    static_assert(std::contiguous_iterator<vector<int>::iterator> && std::contiguous_iterator<vector<int>::const_iterator>);
+
+    // Для арифметических T поиск и сравнение идут через SIMD-ядра из simd_kernels.hpp
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr bool operator==(const vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& lhs, const vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+
+        if constexpr (simd::searchable<T>) {
+            return simd::mismatch(std::to_address(lhs.data()), std::to_address(rhs.data()), lhs.size()) == lhs.size();
+        }
+        else {
+            return std::equal(lhs.data(), lhs.data() + lhs.size(), rhs.data());
+        }
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr auto find(const vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, const T& value) {
+        if constexpr (simd::searchable<T>) {
+            return v.cbegin() + simd::find(std::to_address(v.data()), v.size(), value);
+        }
+        else {
+            return v.cbegin() + (std::find(v.data(), v.data() + v.size(), value) - v.data());
+        }
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr auto find(vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, const T& value) {
+        if constexpr (simd::searchable<T>) {
+            return v.begin() + simd::find(std::to_address(v.data()), v.size(), value);
+        }
+        else {
+            return v.begin() + (std::find(v.data(), v.data() + v.size(), value) - v.data());
+        }
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr std::size_t count(const vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, const T& value) {
+        if constexpr (simd::searchable<T>) {
+            return simd::count(std::to_address(v.data()), v.size(), value);
+        }
+        else {
+            return static_cast<std::size_t>(std::count(v.data(), v.data() + v.size(), value));
+        }
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr bool contains(const vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, const T& value) {
+        return find(v, value) != v.cend();
+    }
+
+    // Первая позиция расхождения в пределах общей длины
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr auto mismatch(const vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& lhs, const vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& rhs) {
+        const std::size_t common = std::min(lhs.size(), rhs.size());
+
+        std::size_t index = 0;
+        if constexpr (simd::searchable<T>) {
+            index = simd::mismatch(std::to_address(lhs.data()), std::to_address(rhs.data()), common);
+        }
+        else {
+            index = std::mismatch(lhs.data(), lhs.data() + common, rhs.data()).first - lhs.data();
+        }
+
+        return std::make_pair(lhs.cbegin() + index, rhs.cbegin() + index);
+    }
+
+    // Как std::erase/std::erase_if для std::vector: один проход, возвращают число удалённых
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats, typename Pred>
+    constexpr std::size_t erase_if(vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, Pred pred) {
+        return v.retain([&](const T& element) { return !static_cast<bool>(pred(element)); });
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats, typename U>
+    constexpr std::size_t erase(vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, const U& value) {
+        return erase_if(v, [&](const T& element) { return element == value; });
+    }
+
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr void swap(vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& lhs, vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>& rhs)
+        noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+
+    // Вектор со встроенным буфером на N элементов; в кучу уходит только при size() > N
+    template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+    using small_vector = vector<T, Allocator, growth_2x, N>;
+
+    // Векторы на std::pmr::memory_resource, например на общем monotonic_buffer_resource запроса.
+    // Вложенные pmr-контейнеры получают тот же ресурс через uses-allocator construction.
+    namespace pmr {
+        template <typename T>
+        using vector = np::vector<T, std::pmr::polymorphic_allocator<T>>;
+
+        template <typename T, std::size_t N>
+        using small_vector = np::vector<T, std::pmr::polymorphic_allocator<T>, growth_2x, N>;
+    }
+
+    // Встроенный буфер адресуется указателем на самого себя, такой вектор переносить memcpy нельзя
+    template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    struct is_trivially_relocatable<vector<T, Allocator, GrowthPolicy, InlineCapacity, Stats>>
+        : std::bool_constant<InlineCapacity == 0 && is_trivially_relocatable_v<Allocator>> {};
 }
+
+#include "vectorBool.hpp"
@@ -1,142 +1,526 @@
-/*#pragma once
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "vector.hpp"
 
-template <>
-class Vector<bool> {
-    struct Bit_reference {
-        std::uint8_t* bucket_ptr_;
-        std::uint8_t  pos_;
+namespace np {
+    // Битовый вектор: по биту на элемент в 64-битных словах, хранилище - обычный np::vector слов
+    // с той же политикой роста, аллокатором и счётчиками. Биты за size() в последнем слове всегда
+    // нулевые, поэтому сравнение, count и поразрядные операции идут по словам целиком.
+    template <typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    class vector<bool, Allocator, GrowthPolicy, InlineCapacity, Stats> {
+        using word_type = std::uint64_t;
+        static constexpr std::size_t word_bits = 64;
+
+        using word_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<word_type>;
+        using storage_type = vector<word_type, word_allocator, GrowthPolicy, (InlineCapacity + word_bits - 1) / word_bits, Stats>;
+
+    public:
+        using value_type = bool;
+        using allocator_type = Allocator;
+        using stats_type = Stats;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // Ссылка на отдельный бит: слово + маска
+        class reference {
+        public:
+            constexpr reference(word_type* word, const word_type mask) noexcept : word_(word), mask_(mask) {}
+
+            constexpr reference(const reference&) noexcept = default;
+
+            constexpr reference& operator=(const bool value) noexcept {
+                set_(value);
+                return *this;
+            }
+
+            constexpr reference& operator=(const reference& other) noexcept {
+                return *this = static_cast<bool>(other);
+            }
+
+            // Присваивание через const-ссылку нужно std::indirectly_writable для прокси
+            constexpr const reference& operator=(const bool value) const noexcept {
+                set_(value);
+                return *this;
+            }
+
+            constexpr operator bool() const noexcept {
+                return (*word_ & mask_) != 0;
+            }
+
+            constexpr bool operator~() const noexcept {
+                return !static_cast<bool>(*this);
+            }
+
+            constexpr reference& flip() noexcept {
+                *word_ ^= mask_;
+                return *this;
+            }
+
+            friend constexpr void swap(reference lhs, reference rhs) noexcept {
+                const bool temp = lhs;
+                lhs = static_cast<bool>(rhs);
+                rhs = temp;
+            }
+
+        private:
+            constexpr void set_(const bool value) const noexcept {
+                value ? *word_ |= mask_ : *word_ &= ~mask_;
+            }
 
-        Bit_reference(std::uint8_t* ptr, const std::uint8_t pos) : bucket_ptr_(ptr), pos_(pos) {}
+            word_type* word_;
+            word_type mask_;
+        };
+
+        using const_reference = bool;
+
+    private:
+        template <bool is_const>
+        class base_iterator {
+        public:
+            using owner_type = std::conditional_t<is_const, const vector, vector>;
+            using reference_type = std::conditional_t<is_const, bool, typename vector::reference>;
+            using difference_type = std::ptrdiff_t;
+            using value_type = bool;
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = std::random_access_iterator_tag;
+
+            owner_type* owner_ = nullptr;
+            size_type index_ = 0;
+
+            /***************************/
+            constexpr base_iterator() noexcept = default;
+
+            constexpr base_iterator(owner_type* owner, const size_type index) noexcept : owner_(owner), index_(index) {}
+
+            // iterator -> const_iterator
+            template <bool other_const> requires (is_const && !other_const)
+            constexpr base_iterator(const base_iterator<other_const>& other) noexcept : owner_(other.owner_), index_(other.index_) {}
+            /***************************/
+
+
+            /***************************/
+            constexpr reference_type operator*() const {
+                return (*owner_)[index_];
+            }
+
+            constexpr reference_type operator[](const difference_type index) const {
+                return (*owner_)[index_ + index];
+            }
+            /***************************/
+
+
+
+            /***************************/
+            constexpr base_iterator& operator++() noexcept {
+                ++index_;
+                return *this;
+            }
+
+            constexpr base_iterator& operator--() noexcept {
+                --index_;
+                return *this;
+            }
+
+            constexpr base_iterator operator++(int) noexcept {
+                base_iterator temp = *this;
+                ++index_;
+                return temp;
+            }
+
+            constexpr base_iterator operator--(int) noexcept {
+                base_iterator temp = *this;
+                --index_;
+                return temp;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            constexpr base_iterator operator+(const difference_type value) const noexcept {
+                return base_iterator(owner_, index_ + value);
+            }
+
+            friend constexpr base_iterator operator+(const difference_type value, const base_iterator& it) noexcept {
+                return it + value;
+            }
+
+            constexpr base_iterator operator-(const difference_type value) const noexcept {
+                return base_iterator(owner_, index_ - value);
+            }
+
+            constexpr difference_type operator-(const base_iterator& other) const noexcept {
+                return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+            }
+
+            constexpr base_iterator& operator+=(const difference_type value) noexcept {
+                index_ += value;
+                return *this;
+            }
+
+            constexpr base_iterator& operator-=(const difference_type value) noexcept {
+                index_ -= value;
+                return *this;
+            }
+            /***************************/
+
+
+
+            /***************************/
+            constexpr bool operator==(const base_iterator& other) const noexcept {
+                return index_ == other.index_;
+            }
+
+            constexpr auto operator<=>(const base_iterator& other) const noexcept {
+                return index_ <=> other.index_;
+            }
+            /***************************/
+        };
+
+    public:
+        using iterator = base_iterator<false>;
+        using const_iterator = base_iterator<true>;
+
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    public:
+        constexpr vector() noexcept = default;
+
+        constexpr explicit vector(const allocator_type& alloc) noexcept : words_(word_allocator(alloc)) {}
+
+        constexpr explicit vector(const size_type n, const allocator_type& alloc = allocator_type()) : vector(n, false, alloc) {}
+
+        constexpr vector(const size_type n, const bool value, const allocator_type& alloc = allocator_type())
+            : words_(words_for_(n), value ? ~word_type(0) : word_type(0), word_allocator(alloc)), size_(n) {
+            clear_tail_();
+        }
+
+        constexpr vector(const std::initializer_list<bool>& list, const allocator_type& alloc = allocator_type()) : vector(list.begin(), list.end(), alloc) {}
+
+        template <std::input_iterator InputIt>
+        constexpr vector(InputIt first, InputIt last, const allocator_type& alloc = allocator_type()) : words_(word_allocator(alloc)) {
+            if constexpr (std::forward_iterator<InputIt>) {
+                reserve(static_cast<size_type>(std::distance(first, last)));
+            }
+
+            for (; first != last; ++first) {
+                push_back(static_cast<bool>(*first));
+            }
+        }
+
+        constexpr vector(const vector&) = default;
+        constexpr vector(vector&& other) noexcept(std::is_nothrow_move_constructible_v<storage_type>)
+            : words_(std::move(other.words_)), size_(std::exchange(other.size_, 0)) {}
+
+        constexpr vector& operator=(const vector&) = default;
+
+        constexpr vector& operator=(vector&& other) noexcept(std::is_nothrow_move_assignable_v<storage_type>) {
+            if (this != &other) {
+                words_ = std::move(other.words_);
+                size_ = std::exchange(other.size_, 0);
+            }
 
-        Bit_reference operator=(bool bit) {
-            bit ? *bucket_ptr_ |= (static_cast<uint8_t>(1) << pos_) : *bucket_ptr_ &= ~(static_cast<uint8_t>(1) << pos_);
             return *this;
         }
 
-        operator bool() const {
-            return *bucket_ptr_ & (1 << pos_);
+        constexpr ~vector() = default;
+
+        constexpr void swap(vector& other) noexcept(noexcept(words_.swap(other.words_))) {
+            words_.swap(other.words_);
+            std::swap(size_, other.size_);
         }
-    };
 
-    uint8_t* arr;
-    std::size_t size_;
-    std::size_t capacity_;
-public:
-    Bit_reference operator[](std::size_t index) {
-        std::uint8_t pos = index % 8;
-        std::uint8_t* ptr = arr + index / 8;
+        [[nodiscard]] constexpr allocator_type get_allocator() const noexcept {
+            return allocator_type(words_.get_allocator());
+        }
 
-        return Bit_reference(ptr, pos);
-    }
+        // Счётчики политики Stats ведёт хранилище слов
+        [[nodiscard]] constexpr stats_snapshot stats() const noexcept {
+            return words_.stats();
+        }
 
-    Vector(const std::initializer_list<bool>& list) {
-        size_ = list.size();
-        capacity_ = (size_ + 7) / 8;
-        arr = new uint8_t[capacity_]();
+        constexpr stats_type& stats_policy() noexcept { return words_.stats_policy(); }
+        constexpr const stats_type& stats_policy() const noexcept { return words_.stats_policy(); }
 
-        std::size_t i = 0;
-        for (bool value : list) {
-            if (value) {
-                arr[i / 8] |= (static_cast<uint8_t>(1) << (i % 8));
+        /***************************/
+        constexpr iterator begin() noexcept { return iterator(this, 0); }
+        constexpr const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        constexpr const_iterator cbegin() const noexcept { return begin(); }
+
+        constexpr iterator end() noexcept { return iterator(this, size_); }
+        constexpr const_iterator end() const noexcept { return const_iterator(this, size_); }
+        constexpr const_iterator cend() const noexcept { return end(); }
+
+        constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+        /***************************/
+
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            return size_;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept {
+            return words_.capacity() * word_bits;
+        }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept {
+            return std::min(words_.max_size(), npos / word_bits) * word_bits;
+        }
+
+        constexpr void reserve(const size_type new_capacity) {
+            words_.reserve(words_for_(new_capacity));
+        }
+
+        constexpr void shrink_to_fit() {
+            words_.shrink_to_fit();
+        }
+
+        constexpr void clear() noexcept {
+            words_.clear();
+            size_ = 0;
+        }
+
+        constexpr void push_back(const bool value) {
+            if (size_ % word_bits == 0) {
+                words_.push_back(word_type(value));
+            }
+            else if (value) {
+                words_.back() |= mask_(size_);
             }
-            ++i;
+
+            ++size_;
         }
-    }
 
-    Vector& operator=(const Vector& other) {
-        if (this != &other) {
-            delete[] arr;
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-            arr = new uint8_t[capacity_];
-            std::copy(other.arr, other.arr + capacity_, arr);
+        constexpr void pop_back() {
+            --size_;
+            if (size_ % word_bits == 0) {
+                words_.pop_back();
+            }
+            else {
+                words_.back() &= ~mask_(size_);
+            }
         }
-        return *this;
-    }
 
-    std::size_t size() const {
-        return size_;
-    }
+        constexpr void resize(const size_type count, const bool value = false) {
+            if (count > size_ && value && size_ % word_bits != 0) {
+                words_.back() |= ~(mask_(size_) - 1);
+            }
 
-    std::size_t capacity() const {
-        return capacity_;
-    }
+            words_.resize(words_for_(count), value ? ~word_type(0) : word_type(0));
+            size_ = count;
+            clear_tail_();
+        }
 
-    void pop_back() {
-        if (size_ == 0) {
-            throw std::out_of_range("Cannot pop from an empty vector");
+        // Оставляет элементы, для которых pred(bit) истинно, порядок сохраняется
+        template <typename Pred>
+        constexpr size_type retain(Pred pred) {
+            size_type kept = 0;
+            for (size_type i = 0; i < size_; ++i) {
+                const bool bit = test_(i);
+                if (pred(bit)) {
+                    (*this)[kept++] = bit;
+                }
+            }
+
+            const size_type removed = size_ - kept;
+            resize(kept);
+            return removed;
         }
-        --size_;
-        if (arr != nullptr) {
-            std::size_t pos = size_ % 8;
-            arr[size_ / 8] &= ~(static_cast<uint8_t>(1) << (7 - pos));
+
+        /***************************/
+        constexpr reference operator[](const size_type index) {
+            return reference(words_.data() + index / word_bits, mask_(index));
         }
-    }
 
-    void push_back(bool value) {
-        if (size_ == capacity_ * 8) {
-            reserve(capacity_ == 0 ? 1 : capacity_ * 2);
+        constexpr const_reference operator[](const size_type index) const {
+            return test_(index);
         }
-        if (value) {
-            arr[size_ / 8] |= (static_cast<uint8_t>(1) << (size_ % 8));
+
+        constexpr reference at(const size_type index) {
+            check_index_(index);
+            return (*this)[index];
         }
-        ++size_;
-    }
 
-    void reserve(std::size_t new_capacity) {
-        if (new_capacity == capacity_) {
-            return;
+        constexpr const_reference at(const size_type index) const {
+            check_index_(index);
+            return (*this)[index];
+        }
+
+        constexpr reference front() { return (*this)[0]; }
+        constexpr const_reference front() const { return (*this)[0]; }
+
+        constexpr reference back() { return (*this)[size_ - 1]; }
+        constexpr const_reference back() const { return (*this)[size_ - 1]; }
+
+        constexpr void flip(const size_type index) {
+            words_[index / word_bits] ^= mask_(index);
         }
-        else if (new_capacity < capacity_) {
-            std::size_t new_size = std::min(new_capacity, size_);
-            std::size_t new_byte_capacity = (new_capacity + 7) / 8;
-            uint8_t* new_arr = new uint8_t[new_byte_capacity]();
 
-            if (arr != nullptr) {
-                std::size_t current_byte_capacity = (capacity_ + 7) / 8;
-                std::copy(arr, arr + std::min(current_byte_capacity, new_byte_capacity), new_arr);
-                delete[] arr;
+        constexpr void flip() noexcept {
+            for (word_type& word : words_) {
+                word = ~word;
             }
+            clear_tail_();
+        }
+        /***************************/
+
+
+
+        /***************************/
+        // Поразрядные операции над векторами одинаковой длины, по словам через SIMD-ядра
+        constexpr vector& operator&=(const vector& other) {
+            return apply_<simd::bit_op::bit_and>(other);
+        }
 
-            arr = new_arr;
-            capacity_ = new_capacity;
-            size_ = new_size;
+        constexpr vector& operator|=(const vector& other) {
+            return apply_<simd::bit_op::bit_or>(other);
         }
-        else {
-            std::size_t new_byte_capacity = (new_capacity + 7) / 8;
-            uint8_t* new_arr = new uint8_t[new_byte_capacity]();
 
-            if (arr != nullptr) {
-                std::size_t current_byte_capacity = (capacity_ + 7) / 8;
-                std::copy(arr, arr + current_byte_capacity, new_arr);
-                delete[] arr;
+        constexpr vector& operator^=(const vector& other) {
+            return apply_<simd::bit_op::bit_xor>(other);
+        }
+
+        friend constexpr vector operator&(vector lhs, const vector& rhs) { return lhs &= rhs; }
+        friend constexpr vector operator|(vector lhs, const vector& rhs) { return lhs |= rhs; }
+        friend constexpr vector operator^(vector lhs, const vector& rhs) { return lhs ^= rhs; }
+
+        // Число установленных битов
+        [[nodiscard]] constexpr size_type count() const noexcept {
+            return simd::popcount(std::to_address(words_.data()), words_.size());
+        }
+
+        [[nodiscard]] constexpr bool any() const noexcept {
+            return std::any_of(words_.begin(), words_.end(), [](const word_type word) { return word != 0; });
+        }
+
+        [[nodiscard]] constexpr bool none() const noexcept {
+            return !any();
+        }
+
+        [[nodiscard]] constexpr bool all() const noexcept {
+            return count() == size_;
+        }
+
+        // Индекс первого бита, равного value (по умолчанию - установленного), или npos
+        [[nodiscard]] constexpr size_type find_first(const bool value = true) const noexcept {
+            return size_ == 0 ? npos : find_from_(0, value);
+        }
+
+        // То же, но строго после pos; pos за концом, в том числе npos, даёт npos
+        [[nodiscard]] constexpr size_type find_next(const size_type pos, const bool value = true) const noexcept {
+            return pos >= size_ || pos + 1 >= size_ ? npos : find_from_(pos + 1, value);
+        }
+
+        // Сырые слова: бит i лежит в words()[i / 64] под маской 1 << (i % 64)
+        [[nodiscard]] constexpr std::span<const word_type> words() const noexcept {
+            return {std::to_address(words_.data()), words_.size()};
+        }
+        /***************************/
+
+        friend constexpr bool operator==(const vector& lhs, const vector& rhs) {
+            return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_;
+        }
+
+    private:
+        static constexpr size_type words_for_(const size_type bits) noexcept {
+            return (bits + word_bits - 1) / word_bits;
+        }
+
+        static constexpr word_type mask_(const size_type index) noexcept {
+            return word_type(1) << (index % word_bits);
+        }
+
+        constexpr bool test_(const size_type index) const noexcept {
+            return (words_[index / word_bits] & mask_(index)) != 0;
+        }
+
+        constexpr void check_index_(const size_type index) const {
+            if (index >= size_) {
+                throw std::out_of_range("Index out of range");
             }
+        }
 
-            arr = new_arr;
-            capacity_ = new_capacity;
+        // Обнуляет биты за size() в последнем слове
+        constexpr void clear_tail_() noexcept {
+            if (size_ % word_bits != 0) {
+                words_.back() &= mask_(size_) - 1;
+            }
         }
-    }
 
-    void resize(std::size_t new_size, bool value = false) {
-        reserve(new_size);
-        for (std::size_t i = size_; i < new_size; ++i) {
-            (*this)[i] = value;
+        // Первый бит, равный value, начиная с pos (pos < size()), или npos
+        constexpr size_type find_from_(const size_type pos, const bool value) const noexcept {
+            const word_type invert = value ? word_type(0) : ~word_type(0);
+            const size_type words = words_.size();
+
+            size_type index = pos / word_bits;
+            word_type word = (words_[index] ^ invert) & ~(mask_(pos) - 1);
+
+            while (word == 0) {
+                if (++index == words) {
+                    return npos;
+                }
+                word = words_[index] ^ invert;
+            }
+
+            const size_type found = index * word_bits + static_cast<size_type>(std::countr_zero(word));
+            return found < size_ ? found : npos;
         }
-        size_ = new_size;
-    }
 
-    void clear() {
-        delete[] arr;
-        arr = nullptr;
-        size_ = 0;
-        capacity_ = 0;
+        template <simd::bit_op Op>
+        constexpr vector& apply_(const vector& other) {
+            if (size_ != other.size_) {
+                throw std::invalid_argument("Bit vectors of different sizes");
+            }
+
+            simd::bitwise<Op>(std::to_address(words_.data()), std::to_address(other.words_.data()), words_.size());
+            return *this;
+        }
+
+        storage_type words_;
+        size_type size_ = 0;
+    };
+
+    static_assert(std::random_access_iterator<vector<bool>::iterator> && std::random_access_iterator<vector<bool>::const_iterator>);
+
+    // Поиск и подсчёт для битового вектора - по словам, а не по элементам
+    template <typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr auto find(const vector<bool, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, const bool& value) {
+        const std::size_t index = v.find_first(value);
+        return v.cbegin() + static_cast<std::ptrdiff_t>(index == v.npos ? v.size() : index);
     }
 
-    Vector() = default;
+    template <typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr auto find(vector<bool, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, const bool& value) {
+        const std::size_t index = v.find_first(value);
+        return v.begin() + static_cast<std::ptrdiff_t>(index == v.npos ? v.size() : index);
+    }
 
-    ~Vector() {
-        delete[] arr;
+    template <typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity, typename Stats>
+    constexpr std::size_t count(const vector<bool, Allocator, GrowthPolicy, InlineCapacity, Stats>& v, const bool& value) {
+        return value ? v.count() : v.size() - v.count();
     }
-}; */
\ No newline at end of file
+}